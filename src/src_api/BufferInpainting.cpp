@@ -0,0 +1,187 @@
+/******************************************************************/
+/***            Pierre Allain, INRIA, February 2020				  */
+/***        GNU Affero General Public License version 3			  */
+/******************************************************************/
+
+#include "BufferInpainting.h"
+#include "ocv_rw.h"
+
+BufferInpainting::BufferInpainting() {}
+
+BufferInpainting::BufferInpainting(const Parameters& _parameters) {
+
+	set_parameters(_parameters);
+}
+
+BufferInpainting::~BufferInpainting() {}
+
+void BufferInpainting::set_parameters(const Parameters& _parameters) {
+
+	parameters = _parameters;
+}
+
+const BufferInpainting::Parameters& BufferInpainting::get_parameters() const {
+
+	return parameters;
+}
+
+size_t BufferInpainting::get_pixel_size(const ElementType _type, const int _Nchannels) {
+
+	return (_type == float32 ? sizeof(float) : sizeof(uchar)) * _Nchannels;
+}
+
+void* BufferInpainting::get_view_data(const LightFieldBuffer& _buffer, const unsigned int _u, const unsigned int _v) {
+
+	const size_t row_step = _buffer.row_step ? _buffer.row_step : _buffer.width * get_pixel_size(_buffer.type, 3);
+	const size_t v_step = _buffer.v_step ? _buffer.v_step : _buffer.height * row_step;
+	const size_t u_step = _buffer.u_step ? _buffer.u_step : _buffer.Nv * v_step;
+
+	return (uchar*)_buffer.data + _u * u_step + _v * v_step;
+}
+
+cv::Mat BufferInpainting::wrap(const ImageBuffer& _buffer, const int _Nchannels) {
+
+	const int type = CV_MAKETYPE(_buffer.type == float32 ? CV_32F : CV_8U, _Nchannels);
+	return cv::Mat(_buffer.height, _buffer.width, type, _buffer.data, _buffer.row_step ? _buffer.row_step : cv::Mat::AUTO_STEP);
+}
+
+template <class Timg>
+void BufferInpainting::wrap(const LightFieldBuffer& _buffer, SubaperturesData<Timg>& _subapertures) {
+
+	_subapertures.clear();
+	_subapertures.resize(_buffer.Nu, _buffer.Nv);
+
+	for (unsigned int u = 0; u < _buffer.Nu; u++) {
+		for (unsigned int v = 0; v < _buffer.Nv; v++) {
+			_subapertures(u, v) = Timg(_buffer.height, _buffer.width, (typename Timg::value_type*)get_view_data(_buffer, u, v), _buffer.row_step ? _buffer.row_step : cv::Mat::AUTO_STEP);
+		}
+	}
+
+}
+
+bool BufferInpainting::check(const LightFieldBuffer& _buffer, const std::string& _buffer_name) {
+
+	if (!_buffer.data || _buffer.Nu == 0 || _buffer.Nv == 0 || _buffer.width <= 0 || _buffer.height <= 0) {
+		std::cout << "BufferInpainting : " << _buffer_name << " is empty." << std::endl;
+		return false;
+	}
+
+	return check_row_step(_buffer.row_step, _buffer.width, _buffer.type, 3, _buffer_name);
+}
+
+bool BufferInpainting::check(const ImageBuffer& _buffer, const std::string& _buffer_name, const int _width, const int _height, const int _Nchannels) {
+
+	if (!_buffer.data || _buffer.width != _width || _buffer.height != _height) {
+		std::cout << "BufferInpainting : " << _buffer_name << " is empty or its size differs from views size." << std::endl;
+		return false;
+	}
+
+	return check_row_step(_buffer.row_step, _buffer.width, _buffer.type, _Nchannels, _buffer_name);
+}
+
+bool BufferInpainting::check_row_step(const size_t _row_step, const int _width, const ElementType _type, const int _Nchannels, const std::string& _buffer_name) {
+
+	if (_row_step && _row_step < _width * get_pixel_size(_type, _Nchannels)) {
+		std::cout << "BufferInpainting : row step of " << _buffer_name << " is smaller than a row of image." << std::endl;
+		return false;
+	}
+
+	/*! OpenCV headers require rows aligned on channel values.*/
+	if (_row_step % get_pixel_size(_type, 1) != 0) {
+		std::cout << "BufferInpainting : row step of " << _buffer_name << " is not a multiple of element size." << std::endl;
+		return false;
+	}
+
+	return true;
+}
+
+bool BufferInpainting::inpaint(const LightFieldBuffer& _light_field, const ImageBuffer& _inpainted_subaperture, const ImageBuffer& _mask, const LightFieldBuffer& _light_field_output) const {
+
+	if (!check(_light_field, "light field") || !check(_light_field_output, "output light field")
+		|| !check(_inpainted_subaperture, "inpainted subaperture", _light_field.width, _light_field.height, 3) || !check(_mask, "mask", _light_field.width, _light_field.height, 1)) {
+		return false;
+	}
+
+	if (_light_field_output.Nu != _light_field.Nu || _light_field_output.Nv != _light_field.Nv || _light_field_output.width != _light_field.width
+		|| _light_field_output.height != _light_field.height || _light_field_output.type != _light_field.type) {
+		std::cout << "BufferInpainting : output light field differs from light field in dimensions or type." << std::endl;
+		return false;
+	}
+
+	if (_mask.type != uint8) {
+		std::cout << "BufferInpainting : mask must be of type uint8." << std::endl;
+		return false;
+	}
+
+	if (parameters.subaperture_position.first >= _light_field.Nu || parameters.subaperture_position.second >= _light_field.Nv) {
+		std::cout << "BufferInpainting : subaperture_position is out of range for the light field." << std::endl;
+		return false;
+	}
+
+	/*! Errors of embedding application are reported by return value : no exception reaches caller.*/
+	try {
+
+		/*! Inpainted subaperture is used in floating point. A float32 buffer is used without copy.*/
+		ocv::Timg inpainted_subaperture;
+		if (_inpainted_subaperture.type == float32) {
+			inpainted_subaperture = wrap(_inpainted_subaperture, 3);
+		} else {
+			ocv::convertTo(ocv::Timg8(wrap(_inpainted_subaperture, 3)), inpainted_subaperture, ocv::get_minmax_range<uchar>());
+		}
+
+		/*! Mask is thresholded in a copy, so that caller buffer is left unchanged.*/
+		ocv::Tmask mask = ocv::Tmask(wrap(_mask, 1)).clone();
+		ocv::mask_filter(mask);
+
+		if (_light_field.type == float32) {
+			return inpaint_views<ocv::Timg>(_light_field, inpainted_subaperture, mask, _light_field_output);
+		} else {
+			return inpaint_views<ocv::Timg8>(_light_field, inpainted_subaperture, mask, _light_field_output);
+		}
+
+	} catch (const std::exception& _exception) {
+		std::cout << "BufferInpainting : inpainting failed : " << _exception.what() << std::endl;
+		return false;
+	}
+
+}
+
+template <class Timg>
+bool BufferInpainting::inpaint_views(const LightFieldBuffer& _light_field, const ocv::Timg& _inpainted_subaperture, const ocv::Tmask& _mask, const LightFieldBuffer& _light_field_output) const {
+
+	SubaperturesData<Timg> subapertures;
+	wrap(_light_field, subapertures);
+	subapertures.set_baseline(parameters.baseline);
+
+	SubaperturesData<Timg> subapertures_output;
+	wrap(_light_field_output, subapertures_output);
+
+	SubaperturesInpainting::Parameters inpainting_parameters;
+	inpainting_parameters.subaperture_position = parameters.subaperture_position;
+	inpainting_parameters.inpainting_angular_parameters = parameters.inpainting_angular_parameters;
+	/*! Nothing is written on disk.*/
+	inpainting_parameters.inpainting_angular_parameters.sps_merger_parameters.l_write_result = false;
+
+	SubaperturesInpainting inpainting;
+	inpainting.set_parameters(inpainting_parameters);
+	inpainting.inpaint(subapertures, _inpainted_subaperture, _mask, subapertures_output);
+
+	/*! Views are written in place in caller memory, unless a stage gave a view its own allocation : it is then copied in caller memory.*/
+	SubaperturesData<Timg> views_output;
+	wrap(_light_field_output, views_output);
+	for (unsigned int u = 0; u < views_output.get_Nu(); u++) {
+		for (unsigned int v = 0; v < views_output.get_Nv(); v++) {
+
+			if (subapertures_output(u, v).size() != views_output(u, v).size()) {
+				std::cout << "BufferInpainting : inpainting failed." << std::endl;
+				return false;
+			}
+
+			if (subapertures_output(u, v).data != views_output(u, v).data) {
+				subapertures_output(u, v).copyTo(views_output(u, v));
+			}
+		}
+	}
+
+	return true;
+}
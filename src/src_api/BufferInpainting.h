@@ -0,0 +1,98 @@
+/******************************************************************/
+/***            Pierre Allain, INRIA, February 2020				  */
+/***        GNU Affero General Public License version 3			  */
+/******************************************************************/
+
+#pragma once
+
+#include "SubaperturesInpainting.h"
+
+/*! Light field inpainting on memory owned by caller, for applications embedding inpainting instead of running FastLFInpainting on files.
+Light field views are wrapped as OpenCV headers on caller buffers without copy, and results are written in place in caller output buffers.
+Only the inpainted subaperture and the mask, single images, are converted to internal types. Nothing is read from or written to disk : result images
+of intermediate stages are disabled through their parameters (see SpsMaskMerge::Parameters::l_write_result).*/
+class BufferInpainting {
+
+public :
+
+	/*! Type of buffer elements. Light field views and inpainted subaperture have 3 channels (BGR), with values in [0,255] for uint8 and in [0,1] for float32.
+	Mask has 1 channel of type uint8, non zero values being masked.*/
+	enum ElementType {
+		uint8,
+		float32
+	};
+
+	/*! Image in caller memory.*/
+	struct ImageBuffer {
+		void* data = nullptr;
+		int width = 0;
+		int height = 0;
+		ElementType type = uint8;
+		/*! Bytes between two rows, multiple of element size. Rows are packed if 0.*/
+		size_t row_step = 0;
+	};
+
+	/*! Grid of Nu x Nv views in caller memory. View (u, v) starts at data + u * u_step + v * v_step.
+	Default steps describe views stored one after the other. Views tiled in a single image are described by v_step being the row size of a view, and row_step the row size of whole image.*/
+	struct LightFieldBuffer {
+		void* data = nullptr;
+		unsigned int Nu = 0;
+		unsigned int Nv = 0;
+		/*! Size of a view.*/
+		int width = 0;
+		int height = 0;
+		ElementType type = uint8;
+		/*! Bytes between two rows of a view, multiple of element size. Rows are packed if 0.*/
+		size_t row_step = 0;
+		/*! Bytes between views (u, v) and (u, v + 1). height * row_step if 0.*/
+		size_t v_step = 0;
+		/*! Bytes between views (u, v) and (u + 1, v). Nv * v_step if 0.*/
+		size_t u_step = 0;
+	};
+
+	struct Parameters {
+		/*! Coordinates of inpainted subaperture in light field coordinates (u,v).*/
+		UVindices subaperture_position = { (unsigned int)4, (unsigned int)4 };
+		/*! Baseline of light field in u and v directions.*/
+		Fpair baseline = { 1., 1. };
+		/*! Parameters of epipolar inpainting.*/
+		InpaintingAngular::Parameters inpainting_angular_parameters;
+	};
+
+private :
+
+	Parameters parameters;
+
+public :
+
+	BufferInpainting();
+	BufferInpainting(const Parameters& _parameters);
+	~BufferInpainting();
+
+	void set_parameters(const Parameters& _parameters);
+	const Parameters& get_parameters() const;
+
+	/*! Inpaints \p _light_field in \p _light_field_output, of same dimensions and type. Output may be the input buffer, for inpainting in place.
+	Returns false if buffers are inconsistent, in which case output is left unchanged, or if inpainting failed. No exception is raised.*/
+	bool inpaint(const LightFieldBuffer& _light_field, const ImageBuffer& _inpainted_subaperture, const ImageBuffer& _mask, const LightFieldBuffer& _light_field_output) const;
+
+	/*! Views of \p _subapertures become headers on \p _buffer, without copy. \p _buffer type must match Timg.*/
+	template <class Timg>
+	static void wrap(const LightFieldBuffer& _buffer, SubaperturesData<Timg>& _subapertures);
+	/*! Header on \p _buffer, without copy, with \p _Nchannels channels.*/
+	static cv::Mat wrap(const ImageBuffer& _buffer, const int _Nchannels);
+
+private :
+
+	template <class Timg>
+	bool inpaint_views(const LightFieldBuffer& _light_field, const ocv::Timg& _inpainted_subaperture, const ocv::Tmask& _mask, const LightFieldBuffer& _light_field_output) const;
+
+	/*! Bytes of a pixel.*/
+	static size_t get_pixel_size(const ElementType _type, const int _Nchannels);
+	/*! Address of view (u, v).*/
+	static void* get_view_data(const LightFieldBuffer& _buffer, const unsigned int _u, const unsigned int _v);
+	static bool check(const LightFieldBuffer& _buffer, const std::string& _buffer_name);
+	static bool check(const ImageBuffer& _buffer, const std::string& _buffer_name, const int _width, const int _height, const int _Nchannels);
+	/*! Row step must hold a row of image and be a multiple of element size.*/
+	static bool check_row_step(const size_t _row_step, const int _width, const ElementType _type, const int _Nchannels, const std::string& _buffer_name);
+};
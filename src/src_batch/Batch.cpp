@@ -0,0 +1,217 @@
+/******************************************************************/
+/***                Fast Inpainting, INRIA license				  */
+/******************************************************************/
+
+#include "Batch.h"
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include "Profiler.h"
+#include "Tracing.h"
+
+Batch::Batch() {}
+
+Batch::~Batch() {}
+
+void Batch::set_parameters(const Parameters& _parameters) {
+
+	parameters = _parameters;
+}
+
+const Batch::Parameters& Batch::get_parameters() const {
+
+	return parameters;
+}
+
+const std::vector<Batch::Result>& Batch::get_results() const {
+
+	return results;
+}
+
+std::string Batch::get_light_field_key(const Master::Parameters& _job) {
+
+	SubaperturesLoader loader(_job.LF_loader_parameters);
+	return loader.get_load_key() + " | " + Misc::to_string(_job.l_8bit_storage);
+}
+
+SubaperturesData<ocv::Timg>& Batch::get_subapertures(CachedLightField& _cached, const ocv::Timg*) {
+
+	return _cached.subapertures;
+}
+
+SubaperturesData<ocv::Timg8>& Batch::get_subapertures(CachedLightField& _cached, const ocv::Timg8*) {
+
+	return _cached.subapertures_8bit;
+}
+
+template <class Timg>
+const SubaperturesData<Timg>* Batch::get_light_field(const SubaperturesLoader& _loader, const std::string& _key, bool& _l_cached) {
+
+	for (typename std::list<CachedLightField>::iterator it = cache.begin(); it != cache.end(); ++it) {
+		if (it->key == _key) {
+			/*! Most recently used first.*/
+			cache.splice(cache.begin(), cache, it);
+			_l_cached = true;
+			return &get_subapertures(cache.front(), (const Timg*)nullptr);
+		}
+	}
+
+	_l_cached = false;
+
+	/*! Least recently used light fields are released before loading, so that at most Ncached_light_fields are held.*/
+	while (!cache.empty() && cache.size() >= std::max(parameters.Ncached_light_fields, 1u)) {
+		cache.pop_back();
+	}
+
+	cache.emplace_front();
+	cache.front().key = _key;
+	SubaperturesData<Timg>& subapertures = get_subapertures(cache.front(), (const Timg*)nullptr);
+
+	if (Master::load(_loader, subapertures)) {
+		return &subapertures;
+	} else {
+		cache.pop_front();
+		return nullptr;
+	}
+
+}
+
+template <class Timg>
+void Batch::run_job(const Master::Parameters& _job, Result& _result, const typename Timg::value_type::value_type _max_value) {
+
+	SubaperturesLoader loader;
+	loader.set_parameters(_job.LF_loader_parameters);
+
+	const SubaperturesData<Timg>* subapertures;
+	{
+		Profiler::Scope scope("load");
+		subapertures = get_light_field<Timg>(loader, get_light_field_key(_job), _result.l_cached);
+		_result.load_time = scope.elapsed();
+	}
+
+	if (subapertures) {
+		Master master;
+		master.set_parameters(_job);
+		_result.l_success = master.process(*subapertures, _max_value, _result.method_time, _result.write_time);
+	}
+
+}
+
+bool Batch::run() {
+
+	results.clear();
+	results.resize(parameters.jobs.size());
+
+	if (parameters.Nthreads > 0) {
+		cv::setNumThreads(parameters.Nthreads);
+	}
+
+	/*! Jobs grouped by light field, groups in order of first appearance : a light field is loaded once as long as it stays in cache.*/
+	std::vector<std::string> keys(parameters.jobs.size());
+	std::map<std::string, unsigned int> first_appearances;
+	for (unsigned int j = 0; j < parameters.jobs.size(); j++) {
+		keys[j] = get_light_field_key(parameters.jobs[j]);
+		first_appearances.emplace(keys[j], j);
+	}
+	std::vector<unsigned int> order(parameters.jobs.size());
+	for (unsigned int j = 0; j < order.size(); j++) {
+		order[j] = j;
+	}
+	std::stable_sort(order.begin(), order.end(), [&](const unsigned int _j1, const unsigned int _j2) {
+		return first_appearances.at(keys[_j1]) < first_appearances.at(keys[_j2]);
+	});
+
+	bool l_success = true;
+
+	for (unsigned int j : order) {
+
+		const Master::Parameters& job = parameters.jobs[j];
+		Result& result = results[j];
+		result.job_name = j < parameters.jobs_names.size() ? parameters.jobs_names[j] : Misc::to_string(j);
+
+		std::cout << "Starting job " << result.job_name << std::endl;
+
+		/*! Results of job are written in its own data path.*/
+		Misc::data_path = job.data_path;
+		Misc::create_directory("");
+
+		/*! Profiling and tracing of job only, as configured by job : records don't pile up along the manifest.*/
+		Profiler::reset();
+		Profiler::set_enabled(!job.profiling_report_name.empty());
+		Tracing::clear();
+		Tracing::set_enabled(job.l_trace);
+
+		{
+			Profiler::Scope scope("job");
+
+			if (job.l_8bit_storage) {
+				run_job<ocv::Timg8>(job, result, 255);
+			} else {
+				run_job<ocv::Timg>(job, result, 1);
+			}
+
+			result.total_time = scope.elapsed();
+		}
+		l_success &= result.l_success;
+
+		if (!job.profiling_report_name.empty()) {
+			Profiler::write_report(Misc::to_data_path(job.profiling_report_name));
+		}
+		if (job.l_trace) {
+			Tracing::write(Misc::to_data_path("trace.json"));
+		}
+
+		std::cout << "Job " << result.job_name << " duration : " << Profiler::to_string_duration(result.total_time) << (result.l_cached ? " (cached light field)" : "") << std::endl;
+	}
+
+	cache.clear();
+	Misc::data_path = parameters.data_path;
+
+	Profiler::reset();
+	Profiler::set_enabled(true);
+	Tracing::clear();
+	Tracing::set_enabled(false);
+
+	return l_success;
+}
+
+bool Batch::write_report(const std::string& _file_path) const {
+
+	std::ofstream file(_file_path);
+
+	if (file.is_open()) {
+
+		file << std::setprecision(6) << std::fixed;
+		file << "{" << std::endl;
+		file << "\t\"Nthreads\" : " << cv::getNumThreads() << "," << std::endl;
+		file << "\t\"Ncached_light_fields\" : " << parameters.Ncached_light_fields << "," << std::endl;
+		file << "\t\"jobs\" : [" << std::endl;
+
+		for (unsigned int i = 0; i < results.size(); i++) {
+
+			const Result& result = results[i];
+			file << "\t\t{ \"name\" : \"" << Misc::json_escape(result.job_name) << "\"";
+			file << ", \"success\" : " << (result.l_success ? "true" : "false");
+			file << ", \"cached\" : " << (result.l_cached ? "true" : "false");
+			file << ", \"load_s\" : " << result.load_time;
+			file << ", \"method_s\" : " << result.method_time;
+			file << ", \"write_s\" : " << result.write_time;
+			file << ", \"total_s\" : " << result.total_time << " }";
+			if (i + 1 < results.size()) {
+				file << ",";
+			}
+			file << std::endl;
+		}
+
+		file << "\t]" << std::endl;
+		file << "}" << std::endl;
+
+		return true;
+
+	} else {
+		std::cout << "WARNING : Failed to write batch report " << _file_path << std::endl;
+		return false;
+	}
+
+}
@@ -0,0 +1,90 @@
+/******************************************************************/
+/***                Fast Inpainting, INRIA license				  */
+/******************************************************************/
+
+#pragma once
+
+#include <list>
+#include "Master.h"
+
+/*! Runs a manifest of inpainting jobs in a single process. Each job is described by a master config file (Master::Parameters).
+Jobs share the OpenCV thread pool, limited to a global number of threads, and loaded light fields are kept in a cache so that jobs targeting the same light field don't load it again.
+Jobs targeting a same light field are run one after the other, in order of first appearance in the manifest. Timings of every job are written as JSON.
+Profiling report and trace of a job, if enabled by its master config, are written in its data_path.*/
+class Batch {
+
+public :
+
+	struct Parameters {
+		/*! Jobs read from manifest.*/
+		std::vector<Master::Parameters> jobs;
+		/*! Names of jobs : their config path as written in manifest.*/
+		std::vector<std::string> jobs_names;
+		/*! Number of threads shared by all jobs. OpenCV default if 0.*/
+		unsigned int Nthreads = 0;
+		/*! Maximum number of loaded light fields kept in cache.*/
+		unsigned int Ncached_light_fields = 1;
+		/*! Path where batch report is written. Each job writes its results in its own data_path.*/
+		std::string data_path;
+		/*! Name of the JSON report written in #data_path.*/
+		std::string report_name = "batch_report.json";
+	};
+
+	/*! Timings of a job, in seconds.*/
+	struct Result {
+		std::string job_name;
+		bool l_success = false;
+		/*! Whether light field was taken from cache.*/
+		bool l_cached = false;
+		double load_time = 0.;
+		double method_time = 0.;
+		double write_time = 0.;
+		double total_time = 0.;
+	};
+
+private :
+
+	Parameters parameters;
+
+	/*! Results in manifest order.*/
+	std::vector<Result> results;
+
+	/*! Loaded light field. Only the view type of the job is filled.*/
+	struct CachedLightField {
+		std::string key;
+		SubaperturesData<ocv::Timg> subapertures;
+		SubaperturesData<ocv::Timg8> subapertures_8bit;
+	};
+	/*! Most recently used first.*/
+	std::list<CachedLightField> cache;
+
+public:
+	Batch();
+	~Batch();
+
+	void set_parameters(const Parameters& _parameters);
+	const Parameters& get_parameters() const;
+
+	/*! Runs every job. Returns false if a job failed.*/
+	bool run();
+	const std::vector<Result>& get_results() const;
+	/*! Writes results in \p _file_path.*/
+	bool write_report(const std::string& _file_path) const;
+
+private :
+
+	/*! Key of light field loaded by job parameters.*/
+	static std::string get_light_field_key(const Master::Parameters& _job);
+
+	/*! Loads, inpaints and writes light field of \p _job, with views of type Timg whose values range from 0 to \p _max_value.*/
+	template <class Timg>
+	void run_job(const Master::Parameters& _job, Result& _result, const typename Timg::value_type::value_type _max_value);
+	/*! Light field loaded by \p _loader : from cache if present, otherwise loaded and cached. nullptr if loading failed.*/
+	template <class Timg>
+	const SubaperturesData<Timg>* get_light_field(const SubaperturesLoader& _loader, const std::string& _key, bool& _l_cached);
+
+	static SubaperturesData<ocv::Timg>& get_subapertures(CachedLightField& _cached, const ocv::Timg*);
+	static SubaperturesData<ocv::Timg8>& get_subapertures(CachedLightField& _cached, const ocv::Timg8*);
+};
+
+#include "Batch_Config.h"
@@ -0,0 +1,102 @@
+/******************************************************************/
+/***                Fast Inpainting, INRIA license				  */
+/******************************************************************/
+
+#include "Batch_Config.h"
+#include <fstream>
+#include "misc_funcs.h"
+#include "ConfigParameter.h"
+#include "ConfigReader.h"
+
+/*! Dedicated config classes. */
+#include "Master_Config.h"
+
+const std::map<ConfigParametersSpecializations<Batch>::ParametersId, std::string> ConfigParametersSpecializations<Batch>::all_parameters = {
+	{ jobs_manifest_path, "jobs_manifest_path" },
+{ Nthreads, "Nthreads" },
+{ Ncached_light_fields, "Ncached_light_fields" },
+{ data_path, "data_path" },
+{ report_name, "report_name" }
+};
+
+bool ConfigParametersSpecializations<Batch>::set_value(Batch::Parameters& _parameters, const std::string& _parameter_name, const std::vector<std::string>& _sub_strings, const std::string& _config_directory) {
+
+	bool l_keep_reading = true;
+
+	if (_parameter_name == all_parameters.at(ParametersId::jobs_manifest_path)) {
+
+		std::string jobs_manifest_path;
+		l_keep_reading = ConfigParameter::read(jobs_manifest_path, _sub_strings, _parameter_name);
+		l_keep_reading &= read_manifest(_parameters, Misc::concat_path_and_filename(_config_directory, jobs_manifest_path));
+
+	} else if (_parameter_name == all_parameters.at(ParametersId::Nthreads)) {
+
+		l_keep_reading = ConfigParameter::read(_parameters.Nthreads, _sub_strings, _parameter_name);
+
+	} else if (_parameter_name == all_parameters.at(ParametersId::Ncached_light_fields)) {
+
+		l_keep_reading = ConfigParameter::read(_parameters.Ncached_light_fields, _sub_strings, _parameter_name);
+
+	} else if (_parameter_name == all_parameters.at(ParametersId::data_path)) {
+
+		l_keep_reading = ConfigParameter::read(_parameters.data_path, _sub_strings, _parameter_name);
+
+	} else if (_parameter_name == all_parameters.at(ParametersId::report_name)) {
+
+		l_keep_reading = ConfigParameter::read(_parameters.report_name, _sub_strings, _parameter_name);
+
+	} else {
+		ConfigBase::display_unknown_parameter(_parameter_name);
+		l_keep_reading = false;
+	}
+
+	return l_keep_reading;
+}
+
+bool ConfigParametersSpecializations<Batch>::read_manifest(Batch::Parameters& _parameters, const std::string& _manifest_path) {
+
+	std::ifstream file(_manifest_path);
+
+	if (!file.is_open()) {
+		std::cout << "Batch : failed to open jobs manifest " << _manifest_path << std::endl;
+		return false;
+	}
+
+	_parameters.jobs.clear();
+	_parameters.jobs_names.clear();
+
+	const std::string manifest_directory = Misc::extract_directory_from_path(_manifest_path);
+
+	std::string line;
+	while (std::getline(file, line)) {
+
+		std::vector<std::string> sub_strings = Misc::get_sub_strings(line);
+		if (sub_strings.empty() || sub_strings[0].empty() || sub_strings[0][0] == '#') {
+			continue;
+		}
+
+		Master::Parameters job;
+		if (ConfigReader::read<Master>(job, Misc::concat_path_and_filename(manifest_directory, sub_strings[0]))) {
+			_parameters.jobs.push_back(job);
+			_parameters.jobs_names.push_back(sub_strings[0]);
+		} else {
+			std::cout << "Batch : failed to read job " << sub_strings[0] << std::endl;
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void ConfigParametersSpecializations<Batch>::deduce_values(Batch::Parameters& _parameters) {
+
+}
+
+void ConfigParametersSpecializations<Batch>::error_message() {
+
+}
+
+std::vector<std::string> ConfigParametersSpecializations<Batch>::check_read_parameters(const std::vector<std::string>& _read_parameters) {
+
+	return ConfigParametersSpecializationsBase::check_read_all_parameters(all_parameters, _read_parameters);
+}
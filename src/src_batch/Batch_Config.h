@@ -0,0 +1,34 @@
+/******************************************************************/
+/***                Fast Inpainting, INRIA license				  */
+/******************************************************************/
+
+#pragma once
+#include "ConfigParameters.h"
+#include "Batch.h"
+
+
+template <>
+struct ConfigParametersSpecializations<Batch> {
+
+private :
+	enum ParametersId { jobs_manifest_path,
+		Nthreads,
+		Ncached_light_fields,
+		data_path,
+		report_name,
+};
+	static const std::map<ParametersId, std::string> all_parameters;
+
+public:
+
+	static bool set_value(Batch::Parameters& _parameters, const std::string& _parameter_name, const std::vector<std::string>& _sub_strings, const std::string& _config_directory);
+	static void deduce_values(Batch::Parameters& _parameters);
+	static void error_message();
+	static std::vector<std::string> check_read_parameters(const std::vector<std::string>& _read_parameters);
+
+private :
+
+	/*! Reads master config files listed in manifest \p _manifest_path, one per line (# for comments). Relative paths are relative to manifest directory.*/
+	static bool read_manifest(Batch::Parameters& _parameters, const std::string& _manifest_path);
+
+};
@@ -0,0 +1,42 @@
+/******************************************************************/
+/***                Fast Inpainting, INRIA license				  */
+/******************************************************************/
+
+#include "Batch.h"
+#include "ConfigReader.h"
+
+#include "version.h"
+
+void usage() {
+  std::cout << "FastLFInpaintingBatch " << FI_VERSION_MAJOR<< "." << FI_VERSION_MINOR << "." << FI_VERSION_PATCH << " : " << std::endl;
+  std::cout << "    Usage : ./FastLFInpaintingBatch <config-file>" << std::endl;
+  std::cout << "    <config-file> full path to the configuration file providing the jobs manifest and batch parameters." << std::endl;
+  exit(0);
+}
+
+int main(int argc, char** argv) {
+
+	Batch batch;
+
+	if (ConfigReader::read(batch, argc, argv)) {
+
+		Misc::data_path = batch.get_parameters().data_path;
+		std::cout << "Data path is set to : " << Misc::data_path << std::endl;
+		std::cout << "Number of jobs : " << batch.get_parameters().jobs.size() << std::endl;
+
+		if (!batch.run()) {
+			std::cout << "Some jobs failed" << std::endl;
+		}
+
+		if (!batch.get_parameters().report_name.empty()) {
+			batch.write_report(Misc::to_data_path(batch.get_parameters().report_name));
+		}
+
+		std::cout << "End of program" << std::endl;
+
+	} else {
+	  usage();
+	}
+
+	return 0;
+}
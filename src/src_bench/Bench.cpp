@@ -0,0 +1,296 @@
+/******************************************************************/
+/***                Fast Inpainting, INRIA license				  */
+/******************************************************************/
+
+#include "Bench.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include "ShiftSubapertures.h"
+#include "Denoising.h"
+#include "HistMatch.h"
+
+const std::vector<std::string>& Bench::kernels_names() {
+	static const std::vector<std::string> _kernels_names_ = {
+		"warp_forward_view",
+		"warp_forward_light_field",
+		"warp_refine",
+		"disparity",
+		"superpixel_segmentation",
+		"sps_merge",
+		"sps_interpolation_compute",
+		"sps_interpolation_apply",
+		"denoise_tvl1",
+		"denoise_tvl1_float",
+		"hist_match",
+		"light_field_expression",
+		"build_full_image",
+		"imwrite",
+		"load"
+	};
+	return _kernels_names_;
+}
+
+Bench::Bench() {}
+
+Bench::~Bench() {}
+
+void Bench::set_parameters(const Parameters& _parameters) {
+
+	parameters = _parameters;
+}
+
+const Bench::Parameters& Bench::get_parameters() const {
+
+	return parameters;
+}
+
+const std::vector<Bench::Result>& Bench::get_results() const {
+
+	return results;
+}
+
+bool Bench::is_selected(const std::string& _kernel) const {
+
+	return Misc::vector_find_bool(parameters.kernels, std::string("all")) || Misc::vector_find_bool(parameters.kernels, _kernel);
+}
+
+void Bench::measure(const std::string& _kernel, const std::function<void()>& _function) {
+
+	if (is_selected(_kernel)) {
+
+		std::cout << "Benchmarking " << _kernel << std::endl;
+
+		for (unsigned int i = 0; i < parameters.Nwarmup; i++) {
+			_function();
+		}
+
+		Result result;
+		result.kernel = _kernel;
+		for (unsigned int i = 0; i < parameters.Nrepetitions; i++) {
+			std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			_function();
+			result.durations.push_back(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+		}
+
+		results.push_back(result);
+	}
+
+}
+
+bool Bench::run() {
+
+	results.clear();
+
+	const SyntheticLightField::Parameters& synthetic_parameters = parameters.synthetic_parameters;
+
+	if (synthetic_parameters.image_size.first == 0 || synthetic_parameters.image_size.second == 0 || synthetic_parameters.angular_size.first == 0 || synthetic_parameters.angular_size.second == 0) {
+		std::cout << "Bench : invalid light field dimensions" << std::endl;
+		return false;
+	}
+
+	SyntheticLightField synthetic(synthetic_parameters);
+	SubaperturesData<> subapertures;
+	ocv::Timg inpainted_image;
+	ocv::Tmask mask;
+	synthetic.generate(subapertures, mask, inpainted_image);
+	UVindices inpainted_indices = synthetic.get_center_indices();
+
+	std::cout << "Synthetic light field : " << subapertures.get_Nu() << "x" << subapertures.get_Nv() << " subapertures of size " << subapertures.get_image_size() << std::endl;
+
+	const InpaintingAngular::Parameters& kernel_parameters = parameters.inpainting_angular_parameters;
+
+	/*! Kernels inputs computed once.*/
+	DisparityFastGradient disparity_computing;
+	disparity_computing.set_parameters(kernel_parameters.disparity_fast_gradient_parameters);
+	ocv::VecImg disparities;
+	disparity_computing.compute(subapertures, inpainted_indices, disparities);
+
+	SuperPixelSegmentation sps;
+	sps.set_parameters(kernel_parameters.sps_parameters);
+	sps.compute(inpainted_image);
+
+	SpsMaskMerge sps_merger;
+	sps_merger.set_parameters(kernel_parameters.sps_merger_parameters);
+	sps_merger.compute(&sps, mask);
+
+	SpsInterpolation sps_interpolation;
+	sps_interpolation.set_parameters(kernel_parameters.sps_interpolation_parameters);
+	sps_interpolation.compute(&sps_merger);
+
+	/*! Outputs.*/
+	SubaperturesData<> subapertures_output;
+	ocv::Timg image_output;
+	ocv::Timg1 disparity_output;
+
+	measure("warp_forward_view", [&]() {
+		Fpair offset(-1., -1.);
+		ShiftSubapertures<ocv::Timg>::warp_forward(inpainted_image, disparities, subapertures.get_baseline(), offset, image_output, true, true, mask);
+	});
+
+	measure("warp_forward_light_field", [&]() {
+		ShiftSubapertures<ocv::Timg>::warp_forward(subapertures, disparities, inpainted_image, mask, inpainted_indices, subapertures_output);
+	});
+
+	measure("warp_refine", [&]() {
+		ShiftSubapertures<ocv::Timg>::warp_refine(subapertures, disparities, inpainted_image, inpainted_indices, Upair(1, 1), subapertures_output);
+	});
+
+	measure("disparity", [&]() {
+		ocv::VecImg disparities_bench;
+		disparity_computing.compute(subapertures, inpainted_indices, disparities_bench);
+	});
+
+	measure("superpixel_segmentation", [&]() {
+		SuperPixelSegmentation sps_bench;
+		sps_bench.set_parameters(kernel_parameters.sps_parameters);
+		sps_bench.compute(inpainted_image);
+	});
+
+	measure("sps_merge", [&]() {
+		SpsMaskMerge sps_merger_bench;
+		sps_merger_bench.set_parameters(kernel_parameters.sps_merger_parameters);
+		sps_merger_bench.compute(&sps, mask);
+	});
+
+	measure("sps_interpolation_compute", [&]() {
+		SpsInterpolation sps_interpolation_bench;
+		sps_interpolation_bench.set_parameters(kernel_parameters.sps_interpolation_parameters);
+		sps_interpolation_bench.compute(&sps_merger);
+	});
+
+	measure("sps_interpolation_apply", [&]() {
+		sps_interpolation.apply(disparities.first, disparity_output);
+	});
+
+	const DisparityFastGradient::Parameters& disparity_parameters = kernel_parameters.disparity_fast_gradient_parameters;
+	Denoising::Buffer<1> denoising_buffer;
+
+	measure("denoise_tvl1", [&]() {
+		Denoising::denoiseTVL1(disparities.first, disparity_output, denoising_buffer, disparity_parameters.lambda_denoise, disparity_parameters.Niterations_denoise);
+	});
+
+	measure("denoise_tvl1_float", [&]() {
+		Denoising::denoiseTVL1Float(disparities.first, disparity_output, denoising_buffer, disparity_parameters.lambda_denoise, disparity_parameters.Niterations_denoise, disparity_parameters.tolerance_denoise);
+	});
+
+	if (is_selected("hist_match")) {
+
+		/*! Same as loader preprocessing : reference CDF computed once, floating point matching of a view.*/
+		const HistMatch::CDF reference_cdf = HistMatch::computeCDF(inpainted_image, 0., 1.);
+		cv::Mat image_matched;
+
+		measure("hist_match", [&]() {
+			subapertures(0, 0).copyTo(image_matched);
+			HistMatch::histMatch(image_matched, reference_cdf);
+		});
+	}
+
+	measure("light_field_expression", [&]() {
+		/*! Chained arithmetic evaluated in a single pass.*/
+		subapertures_output = (subapertures * 0.75 + subapertures) / 1.75;
+	});
+
+	measure("build_full_image", [&]() {
+		subapertures.build_full_image(image_output);
+	});
+
+	/*! Light field written by imwrite kernel is the one read by load kernel.*/
+	const std::string write_directory = "bench_light_field/";
+
+	if (is_selected("imwrite") || is_selected("load")) {
+
+		Misc::create_directory(write_directory);
+
+		measure("imwrite", [&]() {
+			subapertures.imwrite(write_directory, 0., 1.);
+		});
+
+		if (!is_selected("imwrite")) {
+			subapertures.imwrite(write_directory, 0., 1.);
+		}
+	}
+
+	if (is_selected("load")) {
+
+		SubaperturesLoader::Parameters loader_parameters;
+		loader_parameters.LF_path = Misc::to_data_path(write_directory);
+		loader_parameters.Nimages_auto = subapertures.get_Nu() * subapertures.get_Nv();
+		loader_parameters.filter_strings.clear();
+		SubaperturesLoader loader(loader_parameters);
+
+		bool l_loaded = true;
+		measure("load", [&]() {
+			SubaperturesData<> subapertures_loaded;
+			l_loaded &= subapertures_loaded.load(loader);
+		});
+
+		if (!l_loaded) {
+			std::cout << "Bench : failed to load written light field" << std::endl;
+		}
+	}
+
+	return true;
+}
+
+bool Bench::write_report(const std::string& _file_path) const {
+
+	std::ofstream file(_file_path);
+
+	if (file.is_open()) {
+
+		file << std::setprecision(6) << std::fixed;
+		file << "{" << std::endl;
+		const SyntheticLightField::Parameters& synthetic_parameters = parameters.synthetic_parameters;
+		file << "\t\"image_size\" : [" << synthetic_parameters.image_size.first << ", " << synthetic_parameters.image_size.second << "]," << std::endl;
+		file << "\t\"angular_size\" : [" << synthetic_parameters.angular_size.first << ", " << synthetic_parameters.angular_size.second << "]," << std::endl;
+		file << "\t\"disparity_range\" : [" << synthetic_parameters.disparity_range.first << ", " << synthetic_parameters.disparity_range.second << "]," << std::endl;
+		file << "\t\"Nplanes\" : " << synthetic_parameters.Nplanes << "," << std::endl;
+		file << "\t\"mask_ratio\" : " << synthetic_parameters.mask_ratio << "," << std::endl;
+		file << "\t\"seed\" : " << synthetic_parameters.seed << "," << std::endl;
+		file << "\t\"Nrepetitions\" : " << parameters.Nrepetitions << "," << std::endl;
+		file << "\t\"kernels\" : [" << std::endl;
+
+		for (unsigned int i = 0; i < results.size(); i++) {
+
+			std::vector<double> durations = results[i].durations;
+			std::sort(durations.begin(), durations.end());
+			double mean = 0.;
+			for (double duration : durations) {
+				mean += duration;
+			}
+
+			file << "\t\t{ \"name\" : \"" << results[i].kernel << "\"";
+			if (!durations.empty()) {
+				mean /= durations.size();
+				file << ", \"min_s\" : " << durations.front();
+				file << ", \"median_s\" : " << durations[durations.size() / 2];
+				file << ", \"mean_s\" : " << mean;
+				file << ", \"max_s\" : " << durations.back();
+			}
+			file << ", \"durations_s\" : [";
+			for (unsigned int r = 0; r < results[i].durations.size(); r++) {
+				file << results[i].durations[r];
+				if (r + 1 < results[i].durations.size()) {
+					file << ", ";
+				}
+			}
+			file << "] }";
+			if (i + 1 < results.size()) {
+				file << ",";
+			}
+			file << std::endl;
+		}
+
+		file << "\t]" << std::endl;
+		file << "}" << std::endl;
+
+		return true;
+
+	} else {
+		std::cout << "WARNING : Failed to write bench report " << _file_path << std::endl;
+		return false;
+	}
+
+}
@@ -0,0 +1,69 @@
+/******************************************************************/
+/***                Fast Inpainting, INRIA license				  */
+/******************************************************************/
+
+#pragma once
+
+#include <functional>
+#include "SubaperturesData.h"
+#include "InpaintingAngular.h"
+#include "SyntheticLightField.h"
+
+/*! Benchmarks of the pipeline kernels on a synthetic light field. Every kernel is run a number of times and measured with a steady clock.
+Results are written as JSON so that they can be compared with stored baselines.*/
+class Bench {
+
+public :
+
+	struct Parameters {
+		/*! Synthetic light field on which kernels are run (dimensions, disparities, mask ratio).*/
+		SyntheticLightField::Parameters synthetic_parameters;
+		/*! Number of measured runs of each kernel.*/
+		unsigned int Nrepetitions = 5;
+		/*! Number of runs of each kernel before measuring.*/
+		unsigned int Nwarmup = 1;
+		/*! Names of benchmarked kernels. All kernels if it contains "all".*/
+		std::vector<std::string> kernels = { "all" };
+		/*! Parameters of kernels (disparity, superpixels).*/
+		InpaintingAngular::Parameters inpainting_angular_parameters;
+		/*! Path where data are written.*/
+		std::string data_path;
+		/*! Name of the JSON report written in #data_path.*/
+		std::string report_name = "bench_report.json";
+	};
+
+	/*! Measures of a kernel, in seconds.*/
+	struct Result {
+		std::string kernel;
+		std::vector<double> durations;
+	};
+
+	static const std::vector<std::string>& kernels_names();
+
+private :
+
+	Parameters parameters;
+
+	std::vector<Result> results;
+
+public:
+	Bench();
+	~Bench();
+
+	void set_parameters(const Parameters& _parameters);
+	const Parameters& get_parameters() const;
+
+	/*! Runs benchmarks of selected kernels.*/
+	bool run();
+	const std::vector<Result>& get_results() const;
+	/*! Writes results in \p _file_path.*/
+	bool write_report(const std::string& _file_path) const;
+
+private :
+
+	bool is_selected(const std::string& _kernel) const;
+	/*! Runs \p _function Nwarmup times, then measures Nrepetitions runs.*/
+	void measure(const std::string& _kernel, const std::function<void()>& _function);
+};
+
+#include "Bench_Config.h"
@@ -0,0 +1,83 @@
+/******************************************************************/
+/***                Fast Inpainting, INRIA license				  */
+/******************************************************************/
+
+#include "Bench_Config.h"
+#include "misc_funcs.h"
+#include "ConfigParameter.h"
+#include "ConfigReader.h"
+
+/*! Dedicated config classes. */
+#include "InpaintingAngular_Config.h"
+#include "SyntheticLightField_Config.h"
+
+const std::map<ConfigParametersSpecializations<Bench>::ParametersId, std::string> ConfigParametersSpecializations<Bench>::all_parameters = {
+	{ synthetic_config_path, "synthetic_config_path" },
+{ Nrepetitions, "Nrepetitions" },
+{ Nwarmup, "Nwarmup" },
+{ kernels, "kernels" },
+{ inpainting_angular_config_path, "inpainting_angular_config_path" },
+{ data_path, "data_path" },
+{ report_name, "report_name" }
+};
+
+bool ConfigParametersSpecializations<Bench>::set_value(Bench::Parameters& _parameters, const std::string& _parameter_name, const std::vector<std::string>& _sub_strings, const std::string& _config_directory) {
+
+	bool l_keep_reading = true;
+
+	if (_parameter_name == all_parameters.at(ParametersId::synthetic_config_path)) {
+
+		std::string synthetic_config_path;
+		l_keep_reading = ConfigParameter::read(synthetic_config_path, _sub_strings, _parameter_name);
+		l_keep_reading &= ConfigReader::read<SyntheticLightField>(_parameters.synthetic_parameters, Misc::concat_path_and_filename(_config_directory, synthetic_config_path));
+
+	} else if (_parameter_name == all_parameters.at(ParametersId::Nrepetitions)) {
+
+		l_keep_reading = ConfigParameter::read(_parameters.Nrepetitions, _sub_strings, _parameter_name);
+
+	} else if (_parameter_name == all_parameters.at(ParametersId::Nwarmup)) {
+
+		l_keep_reading = ConfigParameter::read(_parameters.Nwarmup, _sub_strings, _parameter_name);
+
+	} else if (_parameter_name == all_parameters.at(ParametersId::kernels)) {
+
+		_parameters.kernels = _sub_strings;
+
+	} else if (_parameter_name == all_parameters.at(ParametersId::inpainting_angular_config_path)) {
+
+		std::string inpainting_angular_config_path;
+		l_keep_reading = ConfigParameter::read(inpainting_angular_config_path, _sub_strings, _parameter_name);
+		l_keep_reading &= ConfigReader::read<InpaintingAngular>(_parameters.inpainting_angular_parameters, Misc::concat_path_and_filename(_config_directory, inpainting_angular_config_path));
+
+	} else if (_parameter_name == all_parameters.at(ParametersId::data_path)) {
+
+		l_keep_reading = ConfigParameter::read(_parameters.data_path, _sub_strings, _parameter_name);
+
+	} else if (_parameter_name == all_parameters.at(ParametersId::report_name)) {
+
+		l_keep_reading = ConfigParameter::read(_parameters.report_name, _sub_strings, _parameter_name);
+
+	} else {
+		ConfigBase::display_unknown_parameter(_parameter_name);
+		l_keep_reading = false;
+	}
+
+	return l_keep_reading;
+}
+
+void ConfigParametersSpecializations<Bench>::deduce_values(Bench::Parameters& _parameters) {
+
+	if (_parameters.Nrepetitions == 0) {
+		std::cout << "WARNING : Nrepetitions must be at least 1. Nrepetitions is set to 1." << std::endl;
+		_parameters.Nrepetitions = 1;
+	}
+}
+
+void ConfigParametersSpecializations<Bench>::error_message() {
+
+}
+
+std::vector<std::string> ConfigParametersSpecializations<Bench>::check_read_parameters(const std::vector<std::string>& _read_parameters) {
+
+	return ConfigParametersSpecializationsBase::check_read_all_parameters(all_parameters, _read_parameters);
+}
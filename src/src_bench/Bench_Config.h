@@ -0,0 +1,31 @@
+/******************************************************************/
+/***                Fast Inpainting, INRIA license				  */
+/******************************************************************/
+
+#pragma once
+#include "ConfigParameters.h"
+#include "Bench.h"
+
+
+template <>
+struct ConfigParametersSpecializations<Bench> {
+
+private :
+	enum ParametersId { synthetic_config_path,
+		Nrepetitions,
+		Nwarmup,
+		kernels,
+		inpainting_angular_config_path,
+		data_path,
+		report_name,
+};
+	static const std::map<ParametersId, std::string> all_parameters;
+
+public:
+
+	static bool set_value(Bench::Parameters& _parameters, const std::string& _parameter_name, const std::vector<std::string>& _sub_strings, const std::string& _config_directory);
+	static void deduce_values(Bench::Parameters& _parameters);
+	static void error_message();
+	static std::vector<std::string> check_read_parameters(const std::vector<std::string>& _read_parameters);
+
+};
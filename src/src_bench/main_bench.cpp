@@ -0,0 +1,49 @@
+/******************************************************************/
+/***                Fast Inpainting, INRIA license				  */
+/******************************************************************/
+
+#include "Bench.h"
+#include "ConfigReader.h"
+#include <algorithm>
+
+#include "version.h"
+
+void usage() {
+  std::cout << "FastLFInpaintingBench " << FI_VERSION_MAJOR<< "." << FI_VERSION_MINOR << "." << FI_VERSION_PATCH << " : " << std::endl;
+  std::cout << "    Usage : ./FastLFInpaintingBench <config-file>" << std::endl;
+  std::cout << "    <config-file> full path to the configuration file providing benchmark parameters." << std::endl;
+  exit(0);
+}
+
+int main(int argc, char** argv) {
+
+	Bench bench;
+
+	if (ConfigReader::read(bench, argc, argv)) {
+
+		Misc::data_path = bench.get_parameters().data_path;
+		std::cout << "Data path is set to : " << Misc::data_path << std::endl;
+
+		if (bench.run()) {
+
+			for (const Bench::Result& result : bench.get_results()) {
+				if (result.durations.empty()) {
+					continue;
+				}
+				double duration_min = *std::min_element(result.durations.begin(), result.durations.end());
+				std::cout << result.kernel << " : " << duration_min * 1000. << " ms (min of " << result.durations.size() << ")" << std::endl;
+			}
+
+			if (!bench.get_parameters().report_name.empty()) {
+				bench.write_report(Misc::to_data_path(bench.get_parameters().report_name));
+			}
+		}
+
+		std::cout << "End of program" << std::endl;
+
+	} else {
+	  usage();
+	}
+
+	return 0;
+}
@@ -0,0 +1,52 @@
+/******************************************************************/
+/***                Fast Inpainting, INRIA license				  */
+/******************************************************************/
+
+#include "ContainerConverter.h"
+#include "misc_funcs.h"
+
+ContainerConverter::ContainerConverter() {}
+
+ContainerConverter::~ContainerConverter() {}
+
+void ContainerConverter::set_parameters(const Parameters& _parameters) {
+
+	parameters = _parameters;
+}
+
+const ContainerConverter::Parameters& ContainerConverter::get_parameters() const {
+
+	return parameters;
+}
+
+bool ContainerConverter::convert() const {
+
+	/*! Preprocessing (spatial cropping, histogram matching) is applied when container is loaded.*/
+	SubaperturesLoader::Parameters loader_parameters = parameters.LF_loader_parameters;
+	loader_parameters.Ncrop_pixels = { { 0,0,0,0 } };
+	loader_parameters.l_histogram_matching = false;
+	SubaperturesLoader loader(loader_parameters);
+
+	if (loader.is_container()) {
+		std::cout << "Light field is already a container : " << parameters.LF_loader_parameters.LF_path << std::endl;
+		return false;
+	}
+
+	SubaperturesData<> subapertures;
+	if (!subapertures.load(loader)) {
+		std::cout << "Failed to load light field " << parameters.LF_loader_parameters.LF_path << std::endl;
+		return false;
+	}
+
+	std::cout << "Loaded light field : " << subapertures.get_Nu() << "x" << subapertures.get_Nv() << " subapertures of size " << subapertures.get_image_size() << std::endl;
+
+	std::string container_name = parameters.container_name;
+	if (!LightFieldContainer::is_container(container_name)) {
+		container_name += LightFieldContainer::file_extension();
+	}
+
+	const std::string container_path = Misc::to_data_path(container_name);
+	std::cout << "Writing container " << container_path << std::endl;
+
+	return subapertures.write_container(container_path);
+}
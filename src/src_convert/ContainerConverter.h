@@ -0,0 +1,42 @@
+/******************************************************************/
+/***                Fast Inpainting, INRIA license				  */
+/******************************************************************/
+
+#pragma once
+
+#include "SubaperturesData.h"
+
+
+/*! Converts a light field loaded with SubaperturesLoader (directory, bundle, video...) in a single LightFieldContainer file.
+Loader transforms (angular cropping, inversion, flips, scaling) are applied before writing, so that container can then be memory mapped as is.
+Preprocessing (spatial cropping, histogram matching) is left to the loading of the container.*/
+class ContainerConverter {
+
+public :
+
+	struct Parameters {
+		/*! Parameters of loaded light field.*/
+		SubaperturesLoader::Parameters LF_loader_parameters;
+		/*! Path where data are written.*/
+		std::string data_path;
+		/*! Name of container file written in #data_path. Container extension is added if missing.*/
+		std::string container_name = "light_field.lfc";
+	};
+
+private :
+
+	Parameters parameters;
+
+public:
+	ContainerConverter();
+	~ContainerConverter();
+
+	void set_parameters(const Parameters& _parameters);
+	const Parameters& get_parameters() const;
+
+	/*! Loads light field and writes container.*/
+	bool convert() const;
+
+};
+
+#include "ContainerConverter_Config.h"
@@ -0,0 +1,27 @@
+/******************************************************************/
+/***                Fast Inpainting, INRIA license				  */
+/******************************************************************/
+
+#pragma once
+#include "ConfigParameters.h"
+#include "ContainerConverter.h"
+
+
+template <>
+struct ConfigParametersSpecializations<ContainerConverter> {
+
+private :
+	enum ParametersId { LF_loader_config_path,
+		data_path,
+		container_name,
+};
+	static const std::map<ParametersId, std::string> all_parameters;
+
+public:
+
+	static bool set_value(ContainerConverter::Parameters& _parameters, const std::string& _parameter_name, const std::vector<std::string>& _sub_strings, const std::string& _config_directory);
+	static void deduce_values(ContainerConverter::Parameters& _parameters);
+	static void error_message();
+	static std::vector<std::string> check_read_parameters(const std::vector<std::string>& _read_parameters);
+
+};
@@ -0,0 +1,37 @@
+/******************************************************************/
+/***                Fast Inpainting, INRIA license				  */
+/******************************************************************/
+
+#include "ContainerConverter.h"
+#include "ConfigReader.h"
+
+#include "version.h"
+
+void usage() {
+  std::cout << "FastLFConvert " << FI_VERSION_MAJOR<< "." << FI_VERSION_MINOR << "." << FI_VERSION_PATCH << " : " << std::endl;
+  std::cout << "    Usage : ./FastLFConvert <config-file>" << std::endl;
+  std::cout << "    <config-file> full path to the configuration file providing light field loader and container name." << std::endl;
+  exit(0);
+}
+
+int main(int argc, char** argv) {
+
+	ContainerConverter converter;
+
+	if (ConfigReader::read(converter, argc, argv)) {
+
+		Misc::data_path = converter.get_parameters().data_path;
+		std::cout << "Data path is set to : " << Misc::data_path << std::endl;
+
+		if (!converter.convert()) {
+			std::cout << "Conversion failed" << std::endl;
+		}
+
+		std::cout << "End of program" << std::endl;
+
+	} else {
+	  usage();
+	}
+
+	return 0;
+}
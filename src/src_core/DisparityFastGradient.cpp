@@ -25,6 +25,26 @@ const DisparityFastGradient::Parameters& DisparityFastGradient::get_parameters()
 	return parameters;
 }
 
+std::vector<UVindices> DisparityFastGradient::get_used_indices(const unsigned int _Nu, const unsigned int _Nv, const UVindices& _subaperture_position) {
+
+	std::vector<UVindices> indices;
+	indices.push_back(_subaperture_position);
+
+	/*! Backward and forward neighbours, or the two first/last ones at borders.*/
+	for (unsigned int u = (unsigned int)std::max(int(_subaperture_position.first) - 1, 0); u <= std::min(_subaperture_position.first + 1, _Nu - 1); u++) {
+		if (u != _subaperture_position.first) {
+			indices.push_back(UVindices(u, _subaperture_position.second));
+		}
+	}
+	for (unsigned int v = (unsigned int)std::max(int(_subaperture_position.second) - 1, 0); v <= std::min(_subaperture_position.second + 1, _Nv - 1); v++) {
+		if (v != _subaperture_position.second) {
+			indices.push_back(UVindices(_subaperture_position.first, v));
+		}
+	}
+
+	return indices;
+}
+
 void DisparityFastGradient::compute(const SubaperturesData<>& _subapertures, const UVindices& _subaperture_position, ocv::Timg1& _disparity) const {
 
 	Buffer buffer;
@@ -187,8 +207,9 @@ void DisparityFastGradient::compute(const SubaperturesData<>& _subapertures, con
 		ocv::bound(_disparities.second, _disparities.second, -parameters.disparity_bound, parameters.disparity_bound);
 
 		if (parameters.l_denoise_disparity) {
-			Denoising::denoiseTVL1(_disparities.first, _disparities.first, _buffer.denoising_buffer, parameters.lambda_denoise, parameters.Niterations_denoise);
-			Denoising::denoiseTVL1(_disparities.second, _disparities.second, _buffer.denoising_buffer, parameters.lambda_denoise, parameters.Niterations_denoise);
+			/*! Floating point denoising keeps sub-pixel precision of disparities.*/
+			Denoising::denoiseTVL1Float(_disparities.first, _disparities.first, _buffer.denoising_buffer, parameters.lambda_denoise, parameters.Niterations_denoise, parameters.tolerance_denoise);
+			Denoising::denoiseTVL1Float(_disparities.second, _disparities.second, _buffer.denoising_buffer, parameters.lambda_denoise, parameters.Niterations_denoise, parameters.tolerance_denoise);
 		}
 
 
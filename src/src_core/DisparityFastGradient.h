@@ -19,12 +19,14 @@ public:
 	struct Parameters {
 		/*! Min/max disparity value.*/
 		ocv::Tvec1 disparity_bound = ocv::Tvalue(3.);
-		/*! Whether disparities are denoised using TVL1.*/
+		/*! Whether disparities are denoised using TVL1 (floating point solver).*/
 		bool l_denoise_disparity = false;
 		/*! Lambda for TVL1 denoising.*/
 		double lambda_denoise = 0.5;
-		/*! Number of iterations for denoising.*/
+		/*! Maximum number of iterations for denoising.*/
 		unsigned int Niterations_denoise = 21;
+		/*! Relative variation of disparity between two iterations under which denoising stops. 0 to run all iterations.*/
+		double tolerance_denoise = 0.;
 	};
 
 	struct Buffer {
@@ -61,6 +63,9 @@ public:
 	void compute(const SubaperturesData<>& _subapertures, SubaperturesData<ocv::Timg1>& _disparity, Buffer& _buffer) const;
 	void compute(const SubaperturesData<>& _subapertures, ocv::Vec< SubaperturesData<ocv::Timg1> >& _disparities, Buffer& _buffer) const;
 
+	/*! Indices of subapertures read when computing disparity at position \p _subaperture_position : itself and its angular neighbours along u and v.*/
+	static std::vector<UVindices> get_used_indices(const unsigned int _Nu, const unsigned int _Nv, const UVindices& _subaperture_position);
+
 	const ocv::VecImg& get_disparities() const;
 	const ocv::Timg1& get_disparity_depth() const;
 };
@@ -13,7 +13,8 @@ const std::map<ConfigParametersSpecializations<DisparityFastGradient>::Parameter
 	{ disparity_bound, "disparity_bound" },
 { l_denoise_disparity, "l_denoise_disparity" },
 { lambda_denoise, "lambda_denoise" },
-{ Niterations_denoise, "Niterations_denoise" }
+{ Niterations_denoise, "Niterations_denoise" },
+{ tolerance_denoise, "tolerance_denoise" }
 };
 
 bool ConfigParametersSpecializations<DisparityFastGradient>::set_value(DisparityFastGradient::Parameters& _parameters, const std::string& _parameter_name, const std::vector<std::string>& _sub_strings, const std::string& _config_directory) {
@@ -37,6 +38,10 @@ bool ConfigParametersSpecializations<DisparityFastGradient>::set_value(Disparity
 
 		l_keep_reading = ConfigParameter::read(_parameters.Niterations_denoise, _sub_strings, _parameter_name);
 
+	} else if (_parameter_name == all_parameters.at(ParametersId::tolerance_denoise)) {
+
+		l_keep_reading = ConfigParameter::read(_parameters.tolerance_denoise, _sub_strings, _parameter_name);
+
 	} else {
 		ConfigBase::display_unknown_parameter(_parameter_name);
 		l_keep_reading = false;
@@ -15,7 +15,8 @@ private:
 		disparity_bound,
 		l_denoise_disparity,
 		lambda_denoise,
-		Niterations_denoise
+		Niterations_denoise,
+		tolerance_denoise
 	};
 	static const std::map<ParametersId, std::string> all_parameters;
 
@@ -5,7 +5,11 @@
 
 #include "InpaintingAngular.h"
 #include "ShiftSubapertures.h"
-#include <ctime>
+#include "InpaintingCheckpoint.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <sstream>
+#include <future>
 
 const std::string InpaintingAngular::directory_name() {
 	static const std::string _directory_name_ = "Inpainting-Angular";
@@ -37,101 +41,496 @@ void InpaintingAngular::inpaint(const SubaperturesData<>& _subapertures, const o
 		}
 		const std::string directory_path = Misc::concat_paths(directory_name_up, directory_name());
 
+		ocv::VecImg disparities_used;
+		if (parameters.checkpoint_path.empty()) {
+			compute_disparities(_subapertures, _inpainted_subaperture, _mask, _inpainted_indices, disparities_used, directory_path);
+		} else {
+			compute_disparities_checkpoint(_subapertures, _inpainted_subaperture, _mask, _inpainted_indices, disparities_used, directory_path);
+		}
 
+		{
+			Profiler::Scope scope("warp");
+			ShiftSubapertures<ocv::Timg>::warp_forward(_subapertures, disparities_used, _inpainted_subaperture, _mask, _inpainted_indices, _subapertures_output);
+		}
 
-		clock_t start;
-		double duration;
+	} else {
 
-		SPS sps;
+		std::cout << "InpaintingAngular : wrong image dimension." << std::endl;
+		std::cout << "Subapertures image size : " << _subapertures.get_image_size() << std::endl;
+		std::cout << "Inpainted image size : " << _inpainted_subaperture.size() << std::endl;
+
+	}
+
+}
+
+void InpaintingAngular::inpaint(const SubaperturesData<ocv::Timg8>& _subapertures, const ocv::Timg& _inpainted_subaperture, const ocv::Tmask& _mask, const UVindices& _inpainted_indices, SubaperturesData<ocv::Timg8>& _subapertures_output, const std::string _directory_name) const {
+
+	if (_inpainted_subaperture.size() == _subapertures.get_image_size()) {
 
-			start = clock();
-			/*! Prepare superpixel interpolation weights.*/
-			superpixel_interpolation_init(sps, _inpainted_subaperture, _mask, directory_path);
-			if (Misc::l_verbose_high) {
-				duration = (clock() - start) / (double)CLOCKS_PER_SEC;
-				std::cout << "Superpixel weights computation time : " << (int)duration / 60 << " min, " << (long)duration % 60 << " s" << std::endl;
-			}
 
-		start = clock();
+		std::string directory_name_up = _directory_name;
+		if (directory_name_up.empty()) {
+			directory_name_up = _subapertures.get_name();
+		}
+		const std::string directory_path = Misc::concat_paths(directory_name_up, directory_name());
+
 		ocv::VecImg disparities_used;
-		ocv::Tvec1 disparity_bound;
-		/*! Whether combination of x and y disparities is mixed into one, accounting for depth estimate.*/
-		bool l_use_single_disparity = false;
+		if (parameters.checkpoint_path.empty()) {
+			/*! Floating point light field restricted to views read by disparity computing.*/
+			SubaperturesData<> subapertures_disparity;
+			_subapertures.convertTo(subapertures_disparity, DisparityFastGradient::get_used_indices(_subapertures.get_Nu(), _subapertures.get_Nv(), _inpainted_indices));
+
+			compute_disparities(subapertures_disparity, _inpainted_subaperture, _mask, _inpainted_indices, disparities_used, directory_path);
+		} else {
+			compute_disparities_checkpoint(_subapertures, _inpainted_subaperture, _mask, _inpainted_indices, disparities_used, directory_path);
+		}
 
+		{
+			Profiler::Scope scope("warp");
+			ShiftSubapertures<ocv::Timg>::warp_forward_region(_subapertures, disparities_used, _inpainted_subaperture, _mask, _inpainted_indices, _subapertures_output);
+		}
 
-			DisparityFastGradient properties_local;
-			properties_local.set_parameters(parameters.disparity_fast_gradient_parameters);
-			if (l_use_single_disparity) {
-				properties_local.compute(_subapertures, _inpainted_indices, disparities_used.first);
-				disparities_used.second = disparities_used.first;
-			} else {
-				properties_local.compute(_subapertures, _inpainted_indices, disparities_used);
-			}
+	} else {
 
-			disparity_bound = properties_local.get_parameters().disparity_bound;
+		std::cout << "InpaintingAngular : wrong image dimension." << std::endl;
+		std::cout << "Subapertures image size : " << _subapertures.get_image_size() << std::endl;
+		std::cout << "Inpainted image size : " << _inpainted_subaperture.size() << std::endl;
 
+	}
+
+}
 
-		if (Misc::l_verbose_high) {
-			duration = (clock() - start) / (double)CLOCKS_PER_SEC;
-			std::cout << "Disparity computation time : " << (int)duration / 60 << " min, " << (long)duration % 60 << " s" << std::endl;
+void InpaintingAngular::inpaint(const SubaperturesData<>& _subapertures, const std::vector<ocv::Timg>& _inpainted_subapertures, const std::vector<ocv::Tmask>& _masks, const std::vector<UVindices>& _inpainted_indices, SubaperturesData<>& _subapertures_output, const std::string _directory_name) const {
+
+	if (check_edits(_subapertures.get_image_size(), _inpainted_subapertures, _masks, _inpainted_indices)) {
+
+		std::string directory_name_up = _directory_name;
+		if (directory_name_up.empty()) {
+			directory_name_up = _subapertures.get_name();
 		}
+		const std::string directory_path = Misc::concat_paths(directory_name_up, directory_name());
 
+		std::vector<ocv::VecImg> disparities_used;
+		compute_disparities(_subapertures, _inpainted_subapertures, _masks, _inpainted_indices, disparities_used, directory_path);
 
+		{
+			Profiler::Scope scope("warp");
+			ShiftSubapertures<ocv::Timg>::warp_forward(_subapertures, disparities_used, _inpainted_subapertures, _masks, _inpainted_indices, _subapertures_output);
+		}
+	}
 
-			start = clock();
-			sps.sps_interpolation.apply(disparities_used.first, disparities_used.first);
-			if (!l_use_single_disparity) {
-				sps.sps_interpolation.apply(disparities_used.second, disparities_used.second);
-			}
-			if (Misc::l_verbose_high) {
-				duration = (clock() - start) / (double)CLOCKS_PER_SEC;
-				std::cout << "Disparity interpolation time : " << (int)duration / 60 << " min, " << (long)duration % 60 << " s" << std::endl;
+}
+
+void InpaintingAngular::inpaint(const SubaperturesData<ocv::Timg8>& _subapertures, const std::vector<ocv::Timg>& _inpainted_subapertures, const std::vector<ocv::Tmask>& _masks, const std::vector<UVindices>& _inpainted_indices, SubaperturesData<ocv::Timg8>& _subapertures_output, const std::string _directory_name) const {
+
+	if (check_edits(_subapertures.get_image_size(), _inpainted_subapertures, _masks, _inpainted_indices)) {
+
+		std::string directory_name_up = _directory_name;
+		if (directory_name_up.empty()) {
+			directory_name_up = _subapertures.get_name();
+		}
+		const std::string directory_path = Misc::concat_paths(directory_name_up, directory_name());
+
+		/*! Floating point light field restricted to views read by disparity computing, for every inpainted position.*/
+		std::vector<UVindices> used_indices;
+		for (const UVindices& inpainted_indices : _inpainted_indices) {
+			for (const UVindices& indices : DisparityFastGradient::get_used_indices(_subapertures.get_Nu(), _subapertures.get_Nv(), inpainted_indices)) {
+				if (!Misc::vector_find_bool(used_indices, indices)) {
+					used_indices.push_back(indices);
+				}
 			}
+		}
+		SubaperturesData<> subapertures_disparity;
+		_subapertures.convertTo(subapertures_disparity, used_indices);
+
+		std::vector<ocv::VecImg> disparities_used;
+		compute_disparities(subapertures_disparity, _inpainted_subapertures, _masks, _inpainted_indices, disparities_used, directory_path);
+		subapertures_disparity.clear();
+
+		{
+			Profiler::Scope scope("warp");
+			ShiftSubapertures<ocv::Timg>::warp_forward_region(_subapertures, disparities_used, _inpainted_subapertures, _masks, _inpainted_indices, _subapertures_output);
+		}
+	}
+
+}
+
+void InpaintingAngular::inpaint(const SubaperturesData<>& _subapertures, const ocv::Timg& _inpainted_subaperture, const ocv::Tmask& _mask, const UVindices& _inpainted_indices, EditCache& _edit_cache, SubaperturesData<>& _subapertures_output, const std::string _directory_name) const {
+
+	if (check_edits(_subapertures.get_image_size(), std::vector<ocv::Timg>(1, _inpainted_subaperture), std::vector<ocv::Tmask>(1, _mask), std::vector<UVindices>(1, _inpainted_indices))) {
+
+		std::string directory_name_up = _directory_name;
+		if (directory_name_up.empty()) {
+			directory_name_up = _subapertures.get_name();
+		}
+		const std::string directory_path = Misc::concat_paths(directory_name_up, directory_name());
+
+		complete_edit_cache(_subapertures, _inpainted_subaperture, _mask, _inpainted_indices, _edit_cache, directory_path);
+
+		ocv::VecImg disparities_used;
+		interpolate_disparities(_edit_cache, disparities_used);
+
+		{
+			Profiler::Scope scope("warp");
+			ShiftSubapertures<ocv::Timg>::warp_forward(_subapertures, disparities_used, _inpainted_subaperture, _mask, _inpainted_indices, _subapertures_output);
+		}
+	}
+
+}
+
+void InpaintingAngular::inpaint(const SubaperturesData<ocv::Timg8>& _subapertures, const ocv::Timg& _inpainted_subaperture, const ocv::Tmask& _mask, const UVindices& _inpainted_indices, EditCache& _edit_cache, SubaperturesData<ocv::Timg8>& _subapertures_output, const std::string _directory_name) const {
+
+	if (check_edits(_subapertures.get_image_size(), std::vector<ocv::Timg>(1, _inpainted_subaperture), std::vector<ocv::Tmask>(1, _mask), std::vector<UVindices>(1, _inpainted_indices))) {
+
+		std::string directory_name_up = _directory_name;
+		if (directory_name_up.empty()) {
+			directory_name_up = _subapertures.get_name();
+		}
+		const std::string directory_path = Misc::concat_paths(directory_name_up, directory_name());
+
+		/*! Floating point light field restricted to views read by disparity computing, only if disparities have to be computed.*/
+		SubaperturesData<> subapertures_disparity;
+		complete_edit_cache(get_disparity_subapertures(_subapertures, _inpainted_indices, _edit_cache, subapertures_disparity), _inpainted_subaperture, _mask, _inpainted_indices, _edit_cache, directory_path);
+		subapertures_disparity.clear();
+
+		ocv::VecImg disparities_used;
+		interpolate_disparities(_edit_cache, disparities_used);
+
+		{
+			Profiler::Scope scope("warp");
+			ShiftSubapertures<ocv::Timg>::warp_forward_region(_subapertures, disparities_used, _inpainted_subaperture, _mask, _inpainted_indices, _subapertures_output);
+		}
+	}
+
+}
+
+void InpaintingAngular::complete_edit_cache(const SubaperturesData<>& _subapertures, const ocv::Timg& _inpainted_subaperture, const ocv::Tmask& _mask, const UVindices& _inpainted_indices, EditCache& _edit_cache, const std::string& _directory_path, InpaintingCheckpoint* _checkpoint) const {
+
+	/*! Parent profiling stage, for stages running in other threads.*/
+	const std::string profiler_path = Profiler::get_current_path();
+
+	/*! As in compute_disparities, superpixels and disparity run concurrently.*/
+	std::future<void> sps_future;
+	if (!_edit_cache.sps) {
+		_edit_cache.sps = std::make_shared<SPS>();
+		sps_future = std::async(std::launch::async, [&]() {
+			Profiler::Scope scope("superpixel", profiler_path);
+			superpixel_interpolation_init(*_edit_cache.sps, _inpainted_subaperture, _mask, _directory_path, _checkpoint);
+		});
+	}
+
+	if (!_edit_cache.disparities) {
+		Profiler::Scope scope("disparity");
+		_edit_cache.disparities = std::make_shared<ocv::VecImg>();
+		DisparityFastGradient properties_local;
+		properties_local.set_parameters(parameters.disparity_fast_gradient_parameters);
+		properties_local.compute(_subapertures, _inpainted_indices, *_edit_cache.disparities);
+		if (_checkpoint) {
+			_checkpoint->write_disparities(*_edit_cache.disparities, false);
+		}
+	}
+
+	/*! Exceptions of superpixels stage are raised here.*/
+	if (sps_future.valid()) {
+		sps_future.get();
+	}
+
+}
+
+template <class Timg>
+void InpaintingAngular::compute_disparities_checkpoint(const SubaperturesData<Timg>& _subapertures, const ocv::Timg& _inpainted_subaperture, const ocv::Tmask& _mask, const UVindices& _inpainted_indices, ocv::VecImg& _disparities, const std::string& _directory_path) const {
+
+	InpaintingCheckpoint checkpoint;
+	checkpoint.open(parameters.checkpoint_path, get_checkpoint_key(_subapertures, _inpainted_subaperture, _mask, _inpainted_indices));
+
+	/*! Last stage before warping : nothing else is needed.*/
+	if (checkpoint.read_disparities(_disparities, true) && _disparities.first.size() == _mask.size() && _disparities.second.size() == _mask.size()) {
+		std::cout << "Interpolated disparities read from checkpoint" << std::endl;
+		return;
+	}
+
+	/*! Stage outputs found in checkpoint are restored in an edit cache, the missing ones are computed and checkpointed by complete_edit_cache.*/
+	EditCache edit_cache;
+	ocv::VecImg disparities;
+	if (checkpoint.read_disparities(disparities, false) && disparities.first.size() == _mask.size() && disparities.second.size() == _mask.size()) {
+		std::cout << "Disparities read from checkpoint" << std::endl;
+		edit_cache.disparities = std::make_shared<ocv::VecImg>(disparities);
+	}
+
+	/*! Floating point light field restricted to views read by disparity computing, only if disparities have to be computed.*/
+	SubaperturesData<> subapertures_disparity;
+	complete_edit_cache(get_disparity_subapertures(_subapertures, _inpainted_indices, edit_cache, subapertures_disparity), _inpainted_subaperture, _mask, _inpainted_indices, edit_cache, _directory_path, &checkpoint);
+	subapertures_disparity.clear();
+
+	interpolate_disparities(edit_cache, _disparities);
+	checkpoint.write_disparities(_disparities, true);
+
+}
+
+template <class Timg>
+std::string InpaintingAngular::get_checkpoint_key(const SubaperturesData<Timg>& _subapertures, const ocv::Timg& _inpainted_subaperture, const ocv::Tmask& _mask, const UVindices& _inpainted_indices) const {
+
+	const DisparityFastGradient::Parameters& disparity_parameters = parameters.disparity_fast_gradient_parameters;
+	const SuperPixelSegmentation::Parameters& sps_parameters = parameters.sps_parameters;
+
+	std::ostringstream description;
+	description << _subapertures.get_name() << " " << _subapertures.get_Nu() << "x" << _subapertures.get_Nv() << " " << _subapertures.get_image_size() << " " << sizeof(typename Timg::value_type::value_type);
+	description << " | " << _inpainted_indices.first << " " << _inpainted_indices.second;
+	description << " | " << parameters.disparity_smoothness;
+	description << " | " << disparity_parameters.disparity_bound[0] << " " << disparity_parameters.l_denoise_disparity << " " << disparity_parameters.lambda_denoise << " " << disparity_parameters.Niterations_denoise << " " << disparity_parameters.tolerance_denoise;
+	description << " | " << sps_parameters.Nsuperpixels << " " << sps_parameters.Nsuperpixels_per_pixel << " " << sps_parameters.ruler_coef << " " << sps_parameters.Niterations << " " << sps_parameters.conversion_type << " " << sps_parameters.sigma_blur;
+	description << " | " << parameters.sps_merger_parameters.Nknown_pixels_min << " " << parameters.sps_merger_parameters.merge_coef;
+	description << " | " << parameters.sps_interpolation_parameters.Nweight_pixels << " " << parameters.sps_interpolation_parameters.distance_coef << " " << parameters.sps_interpolation_parameters.sigma_coef;
+
+	/*! Values of views read by disparity computing are hashed too : a light field exported again with same name and dimensions is another job.*/
+	std::vector<cv::Mat> images = { _inpainted_subaperture, _mask };
+	for (const UVindices& indices : DisparityFastGradient::get_used_indices(_subapertures.get_Nu(), _subapertures.get_Nv(), _inpainted_indices)) {
+		images.push_back(_subapertures[indices]);
+	}
+
+	return InpaintingCheckpoint::get_key(images, description.str());
+}
+
+const SubaperturesData<>& InpaintingAngular::get_disparity_subapertures(const SubaperturesData<>& _subapertures, const UVindices& _inpainted_indices, const EditCache& _edit_cache, SubaperturesData<>& _buffer) {
+
+	return _subapertures;
+}
+
+const SubaperturesData<>& InpaintingAngular::get_disparity_subapertures(const SubaperturesData<ocv::Timg8>& _subapertures, const UVindices& _inpainted_indices, const EditCache& _edit_cache, SubaperturesData<>& _buffer) {
+
+	if (!_edit_cache.disparities) {
+		_subapertures.convertTo(_buffer, DisparityFastGradient::get_used_indices(_subapertures.get_Nu(), _subapertures.get_Nv(), _inpainted_indices));
+	}
+	return _buffer;
+}
+
+void InpaintingAngular::update_edit_cache(EditCache& _edit_cache, const ocv::Tmask& _mask) const {
+
+	Profiler::Scope scope("superpixel");
+
+	SPS& sps = *_edit_cache.sps;
+
+	/*! Merge overwrites its labels and mask : previous ones are copied for comparison.*/
+	const cv::Mat labels_previous = sps.sps_merger.get_labels().clone();
+	const ocv::Tmask mask_previous = sps.sps_merger.get_mask().clone();
+
+	{
+		Profiler::Scope scope("merge");
+		sps.sps_merger.compute(&sps.sps, _mask);
+	}
+
+	{
+		Profiler::Scope scope("weights");
+		sps.sps_interpolation.update(&sps.sps_merger, labels_previous, mask_previous);
+	}
+
+}
+
+void InpaintingAngular::interpolate_disparities(const EditCache& _edit_cache, ocv::VecImg& _disparities) const {
+
+	Profiler::Scope scope("interpolation");
+
+	/*! Cached disparities are kept unchanged.*/
+	_disparities.first = _edit_cache.disparities->first.clone();
+	_disparities.second = _edit_cache.disparities->second.clone();
+
+	auto interpolate_disparity = [&](ocv::Timg1& _disparity) {
+
+		_edit_cache.sps->sps_interpolation.apply(_disparity, _disparity);
 
 		if (parameters.disparity_smoothness > 1) {
 			cv::Size smooth_factor(parameters.disparity_smoothness, parameters.disparity_smoothness);
-			cv::GaussianBlur(disparities_used.first, disparities_used.first, smooth_factor, 0, 0);
+			cv::GaussianBlur(_disparity, _disparity, smooth_factor, 0, 0);
+		}
+	};
 
-			if (!l_use_single_disparity) {
-				/*! Mean second component is an independant image.*/
-				cv::GaussianBlur(disparities_used.second, disparities_used.second, smooth_factor, 0, 0);
-			}
+	std::future<void> disparity_future = std::async(std::launch::async, [&]() {
+		interpolate_disparity(_disparities.second);
+	});
+	interpolate_disparity(_disparities.first);
+	disparity_future.get();
+
+}
+
+bool InpaintingAngular::check_edits(const cv::Size& _image_size, const std::vector<ocv::Timg>& _inpainted_subapertures, const std::vector<ocv::Tmask>& _masks, const std::vector<UVindices>& _inpainted_indices) {
+
+	if (_inpainted_subapertures.size() != _masks.size() || _inpainted_subapertures.size() != _inpainted_indices.size()) {
+		std::cout << "InpaintingAngular : numbers of inpainted subapertures, masks and positions differ." << std::endl;
+		return false;
+	}
+
+	for (unsigned int e = 0; e < _inpainted_subapertures.size(); e++) {
+		if (_inpainted_subapertures[e].size() != _image_size || _masks[e].size() != _image_size) {
+			std::cout << "InpaintingAngular : wrong image dimension for edit " << e << "." << std::endl;
+			std::cout << "Subapertures image size : " << _image_size << std::endl;
+			std::cout << "Inpainted image size : " << _inpainted_subapertures[e].size() << std::endl;
+			std::cout << "Mask image size : " << _masks[e].size() << std::endl;
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void InpaintingAngular::compute_disparities(const SubaperturesData<>& _subapertures, const ocv::Timg& _inpainted_subaperture, const ocv::Tmask& _mask, const UVindices& _inpainted_indices, ocv::VecImg& _disparities, const std::string& _directory_path) const {
+
+	std::vector<ocv::VecImg> disparities;
+	compute_disparities(_subapertures, std::vector<ocv::Timg>(1, _inpainted_subaperture), std::vector<ocv::Tmask>(1, _mask), std::vector<UVindices>(1, _inpainted_indices), disparities, _directory_path);
+	_disparities = disparities.front();
+}
+
+void InpaintingAngular::compute_disparities(const SubaperturesData<>& _subapertures, const std::vector<ocv::Timg>& _inpainted_subapertures, const std::vector<ocv::Tmask>& _masks, const std::vector<UVindices>& _inpainted_indices, std::vector<ocv::VecImg>& _disparities, const std::string& _directory_path) const {
+
+	/*! Parent profiling stage, for stages running in other threads.*/
+	const std::string profiler_path = Profiler::get_current_path();
+
+	const unsigned int Nedits = (unsigned int)_inpainted_subapertures.size();
+
+	std::vector<SPS> sps(Nedits);
+	/*! Whether combination of x and y disparities is mixed into one, accounting for depth estimate.*/
+	bool l_use_single_disparity = false;
+
+	/*! Superpixel weights only depend on inpainted subapertures and masks, while disparity only depends on light field. Both stages run concurrently.
+	Future of std::async waits for its task when destroyed : references captured stay valid if disparity stage raises an exception.*/
+	std::future<void> sps_future = std::async(std::launch::async, [&]() {
+
+		Profiler::Scope scope("superpixel", profiler_path);
+		/*! Prepare superpixel interpolation weights.*/
+		for (unsigned int e = 0; e < Nedits; e++) {
+			superpixel_interpolation_init(sps[e], _inpainted_subapertures[e], _masks[e], _directory_path);
 		}
 
+	});
 
-		start = clock();
-		ShiftSubapertures<ocv::Timg>::warp_forward(_subapertures, disparities_used, _inpainted_subaperture, _mask, _inpainted_indices, _subapertures_output);
-		if (Misc::l_verbose_high) {
-			duration = (clock() - start) / (double)CLOCKS_PER_SEC;
-			std::cout << "Warping time : " << (int)duration / 60 << " min, " << (long)duration % 60 << " s" << std::endl;
+	/*! Distinct inpainted positions, and position of each edit.*/
+	std::vector<UVindices> positions;
+	std::vector<unsigned int> edits_positions(Nedits);
+	for (unsigned int e = 0; e < Nedits; e++) {
+		std::vector<UVindices>::const_iterator it = std::find(positions.begin(), positions.end(), _inpainted_indices[e]);
+		edits_positions[e] = (unsigned int)std::distance(positions.cbegin(), it);
+		if (it == positions.end()) {
+			positions.push_back(_inpainted_indices[e]);
 		}
+	}
 
-	} else {
+	std::vector<ocv::VecImg> disparities_positions(positions.size());
 
-		std::cout << "InpaintingAngular : wrong image dimension." << std::endl;
-		std::cout << "Subapertures image size : " << _subapertures.get_image_size() << std::endl;
-		std::cout << "Inpainted image size : " << _inpainted_subaperture.size() << std::endl;
+	{
+		Profiler::Scope scope("disparity");
 
+		DisparityFastGradient properties_local;
+		properties_local.set_parameters(parameters.disparity_fast_gradient_parameters);
+		for (unsigned int p = 0; p < positions.size(); p++) {
+			if (l_use_single_disparity) {
+				properties_local.compute(_subapertures, positions[p], disparities_positions[p].first);
+				disparities_positions[p].second = disparities_positions[p].first;
+			} else {
+				properties_local.compute(_subapertures, positions[p], disparities_positions[p]);
+			}
+		}
+	}
+
+	/*! Interpolation is applied in place : disparities of a position are copied for every edit but the last one using them.*/
+	_disparities.resize(Nedits);
+	for (unsigned int e = 0; e < Nedits; e++) {
+		const ocv::VecImg& disparities = disparities_positions[edits_positions[e]];
+		if (std::find(edits_positions.begin() + e + 1, edits_positions.end(), edits_positions[e]) != edits_positions.end()) {
+			_disparities[e] = ocv::VecImg(disparities.first.clone(), disparities.second.clone());
+		} else {
+			_disparities[e] = disparities;
+		}
+	}
+	disparities_positions.clear();
+
+	/*! Interpolation needs superpixel weights. Exceptions of superpixels stage are raised here.*/
+	sps_future.get();
+
+
+	/*! Interpolation and smoothing of a disparity plane.*/
+	auto interpolate_disparity = [&](const unsigned int _edit, ocv::Timg1& _disparity) {
+
+		sps[_edit].sps_interpolation.apply(_disparity, _disparity);
+
+		if (parameters.disparity_smoothness > 1) {
+			cv::Size smooth_factor(parameters.disparity_smoothness, parameters.disparity_smoothness);
+			cv::GaussianBlur(_disparity, _disparity, smooth_factor, 0, 0);
+		}
+	};
+
+	{
+		Profiler::Scope scope("interpolation");
+		for (unsigned int e = 0; e < Nedits; e++) {
+			if (!l_use_single_disparity) {
+				/*! Mean second component is an independant image : both planes are processed concurrently.*/
+				std::future<void> disparity_future = std::async(std::launch::async, [&]() {
+					interpolate_disparity(e, _disparities[e].second);
+				});
+				interpolate_disparity(e, _disparities[e].first);
+				disparity_future.get();
+			} else {
+				interpolate_disparity(e, _disparities[e].first);
+				_disparities[e].second = _disparities[e].first;
+			}
+		}
 	}
 
 }
 
-void InpaintingAngular::superpixel_interpolation_init(SPS& _sps, const ocv::Timg& _segmentation_image, const ocv::Tmask& _mask, const std::string& _directory_path) const {
+void InpaintingAngular::superpixel_interpolation_init(SPS& _sps, const ocv::Timg& _segmentation_image, const ocv::Tmask& _mask, const std::string& _directory_path, InpaintingCheckpoint* _checkpoint) const {
 
 	/*! For writing results.*/
 	ocv::Timg image_segmented;
 
 	_sps.sps.set_parameters(parameters.sps_parameters);
-	/*! Compute image segementation.*/
-	_sps.sps.compute(_segmentation_image);
-
 	_sps.sps_merger.set_parameters(parameters.sps_merger_parameters);
-	/*! Compute merger using segmentation and image mask.*/
-	_sps.sps_merger.compute(&_sps.sps, _mask);
+	_sps.sps_interpolation.set_parameters(parameters.sps_interpolation_parameters);
 
+	SpsInterpolation::SparseWeights weights;
+	/*! Weights are all that interpolation needs : segmentation and merge are skipped.*/
+	if (_checkpoint && _checkpoint->read_weights(weights) && weights.size == _segmentation_image.size()) {
+		std::cout << "Interpolation weights read from checkpoint" << std::endl;
+		_sps.sps_interpolation.set_weights(weights);
+		return;
+	}
 
-	_sps.sps_interpolation.set_parameters(parameters.sps_interpolation_parameters);
-	/*! Compute interpolation using merged segmentation.*/
-	_sps.sps_interpolation.compute(&_sps.sps_merger);
+	cv::Mat labels;
+	if (_checkpoint && _checkpoint->read_labels(labels) && labels.size() == _segmentation_image.size()) {
+
+		std::cout << "Merged superpixels read from checkpoint" << std::endl;
+		Profiler::Scope scope("merge");
+		/*! Weights only need image of segmentation and merged labels.*/
+		_sps.sps.set_image(_segmentation_image);
+		_sps.sps_merger.set_labels(&_sps.sps, _mask, labels);
+
+	} else {
+
+		{
+			Profiler::Scope scope("segmentation");
+			/*! Compute image segementation.*/
+			_sps.sps.compute(_segmentation_image);
+		}
+
+		{
+			Profiler::Scope scope("merge");
+			/*! Compute merger using segmentation and image mask.*/
+			_sps.sps_merger.compute(&_sps.sps, _mask);
+			if (_checkpoint) {
+				_checkpoint->write_labels(_sps.sps_merger.get_labels());
+			}
+		}
+	}
+
+	{
+		Profiler::Scope scope("weights");
+		/*! Compute interpolation using merged segmentation.*/
+		_sps.sps_interpolation.compute(&_sps.sps_merger);
+		if (_checkpoint) {
+			_sps.sps_interpolation.get_weights(weights);
+			_checkpoint->write_weights(weights);
+		}
+	}
 
 }
+
+template std::string InpaintingAngular::get_checkpoint_key(const SubaperturesData<>& _subapertures, const ocv::Timg& _inpainted_subaperture, const ocv::Tmask& _mask, const UVindices& _inpainted_indices) const;
+template std::string InpaintingAngular::get_checkpoint_key(const SubaperturesData<ocv::Timg8>& _subapertures, const ocv::Timg& _inpainted_subaperture, const ocv::Tmask& _mask, const UVindices& _inpainted_indices) const;
@@ -5,11 +5,14 @@
 
 #pragma once
 
+#include <memory>
 #include "SubaperturesData.h"
 #include "DisparityFastGradient.h"
 #include "SpsMaskMerge.h"
 #include "SpsInterpolation.h"
 
+class InpaintingCheckpoint;
+
 class InpaintingAngular {
 
 public :
@@ -29,11 +32,13 @@ public :
 		/*! Superpixel interpolation parameters.*/
 		SpsInterpolation::Parameters sps_interpolation_parameters;
 
-	};
-
+		/*! Directory, relative to data path, where stage outputs are checkpointed (see InpaintingCheckpoint) so that an interrupted job resumes from its last completed stage.
+		Used by single edit inpainting without edit cache. No checkpoint if empty.*/
+		std::string checkpoint_path;
 
-private:
+	};
 
+	/*! Superpixel interpolation of an inpainted subaperture with respect to its mask. Members refer to each other : not to be copied.*/
 	struct SPS {
 		/*! Instance of superpixel segmentation.*/
 		SuperPixelSegmentation sps;
@@ -42,7 +47,19 @@ private:
 		/*! Instance of superpixel interpolation (weights computing).*/
 		SpsInterpolation sps_interpolation;
 	};
-	
+
+	/*! Intermediate results of an inpainting that can be kept by caller and reused by later runs.
+	Disparities only depend on light field and inpainted position, superpixel weights only depend on inpainted subaperture and mask.
+	Missing ones are computed and stored by inpaint, present ones are used as is.*/
+	struct EditCache {
+		/*! Disparities of light field at inpainted position, before interpolation inside mask.*/
+		std::shared_ptr<ocv::VecImg> disparities;
+		/*! Superpixel interpolation weights.*/
+		std::shared_ptr<SPS> sps;
+	};
+
+private:
+
 	Parameters parameters;
 
 public:
@@ -52,9 +69,50 @@ public:
 
 	void set_parameters(const Parameters& _parameters);
 	void inpaint(const SubaperturesData<>& _subapertures, const ocv::Timg& _inpainted_subaperture, const ocv::Tmask& _mask, const UVindices& _inpainted_indices, SubaperturesData<>& _subapertures_output, const std::string _directory_name = "") const;
+	/*! Same as floating point inpainting, for views stored in 8 bits. Only views used by disparity computing are converted entirely, and warped views are converted inside mask region only.*/
+	void inpaint(const SubaperturesData<ocv::Timg8>& _subapertures, const ocv::Timg& _inpainted_subaperture, const ocv::Tmask& _mask, const UVindices& _inpainted_indices, SubaperturesData<ocv::Timg8>& _subapertures_output, const std::string _directory_name = "") const;
+
+	/*! Several independent edits of a light field in one pass. Edit e is inpainted subaperture \p _inpainted_subapertures[e] at \p _inpainted_indices[e], with mask \p _masks[e].
+	Disparity of light field is computed once per inpainted position and interpolated inside each mask, then every view is warped once with all edits (see ShiftSubapertures).*/
+	void inpaint(const SubaperturesData<>& _subapertures, const std::vector<ocv::Timg>& _inpainted_subapertures, const std::vector<ocv::Tmask>& _masks, const std::vector<UVindices>& _inpainted_indices, SubaperturesData<>& _subapertures_output, const std::string _directory_name = "") const;
+	void inpaint(const SubaperturesData<ocv::Timg8>& _subapertures, const std::vector<ocv::Timg>& _inpainted_subapertures, const std::vector<ocv::Tmask>& _masks, const std::vector<UVindices>& _inpainted_indices, SubaperturesData<ocv::Timg8>& _subapertures_output, const std::string _directory_name = "") const;
+
+	/*! Same as single inpainted subaperture inpainting, reusing and completing \p _edit_cache.*/
+	void inpaint(const SubaperturesData<>& _subapertures, const ocv::Timg& _inpainted_subaperture, const ocv::Tmask& _mask, const UVindices& _inpainted_indices, EditCache& _edit_cache, SubaperturesData<>& _subapertures_output, const std::string _directory_name = "") const;
+	/*! Same as single inpainted subaperture inpainting, reusing and completing \p _edit_cache. Views are converted for disparity computing only if disparities are missing.*/
+	void inpaint(const SubaperturesData<ocv::Timg8>& _subapertures, const ocv::Timg& _inpainted_subaperture, const ocv::Tmask& _mask, const UVindices& _inpainted_indices, EditCache& _edit_cache, SubaperturesData<ocv::Timg8>& _subapertures_output, const std::string _directory_name = "") const;
+
+	/*! Updates superpixel weights of complete \p _edit_cache for new mask \p _mask : superpixels are merged again, and only weights of merged superpixels
+	whose pixels or masked pixels changed are computed again. Segmentation and disparities are kept. Superpixels of \p _edit_cache are modified : they must not be shared.*/
+	void update_edit_cache(EditCache& _edit_cache, const ocv::Tmask& _mask) const;
+	/*! Disparities of complete \p _edit_cache interpolated inside mask.*/
+	void interpolate_disparities(const EditCache& _edit_cache, ocv::VecImg& _disparities) const;
+
+	/*! Key identifying a job for checkpointing : inpainted subaperture, mask, values of views read by disparity computing, position, light field name and dimensions, and parameters.
+	Instantiated for floating point and 8 bits light fields.*/
+	template <class Timg>
+	std::string get_checkpoint_key(const SubaperturesData<Timg>& _subapertures, const ocv::Timg& _inpainted_subaperture, const ocv::Tmask& _mask, const UVindices& _inpainted_indices) const;
 
 private :
 
-	/*! Initialize superpixel interpolation. Ie : compute interpolation weights in #sps_interpolation.*/
-	void superpixel_interpolation_init(SPS& _sps, const ocv::Timg& _segmentation_image, const ocv::Tmask& _mask, const std::string& _write_path) const;
+	/*! Computes missing members of \p _edit_cache. \p _subapertures is only read if disparities are missing. Computed stage outputs are written in \p _checkpoint if not null.*/
+	void complete_edit_cache(const SubaperturesData<>& _subapertures, const ocv::Timg& _inpainted_subaperture, const ocv::Tmask& _mask, const UVindices& _inpainted_indices, EditCache& _edit_cache, const std::string& _directory_path, InpaintingCheckpoint* _checkpoint = nullptr) const;
+
+	/*! Same as compute_disparities, resuming from stage outputs found in checkpoint of #Parameters::checkpoint_path, and checkpointing the others.*/
+	template <class Timg>
+	void compute_disparities_checkpoint(const SubaperturesData<Timg>& _subapertures, const ocv::Timg& _inpainted_subaperture, const ocv::Tmask& _mask, const UVindices& _inpainted_indices, ocv::VecImg& _disparities, const std::string& _directory_path) const;
+	/*! Floating point light field read by disparity computing : \p _subapertures itself, or its views used by disparity converted in \p _buffer if disparities of \p _edit_cache are missing.*/
+	static const SubaperturesData<>& get_disparity_subapertures(const SubaperturesData<>& _subapertures, const UVindices& _inpainted_indices, const EditCache& _edit_cache, SubaperturesData<>& _buffer);
+	static const SubaperturesData<>& get_disparity_subapertures(const SubaperturesData<ocv::Timg8>& _subapertures, const UVindices& _inpainted_indices, const EditCache& _edit_cache, SubaperturesData<>& _buffer);
+
+	/*! Disparities of inpainted subaperture, interpolated inside mask using superpixels. \p _subapertures may only contain views used by disparity computing.*/
+	void compute_disparities(const SubaperturesData<>& _subapertures, const ocv::Timg& _inpainted_subaperture, const ocv::Tmask& _mask, const UVindices& _inpainted_indices, ocv::VecImg& _disparities, const std::string& _directory_path) const;
+	/*! Disparities of several edits. Disparity of light field is computed once per distinct inpainted position, and interpolated inside mask of each edit.*/
+	void compute_disparities(const SubaperturesData<>& _subapertures, const std::vector<ocv::Timg>& _inpainted_subapertures, const std::vector<ocv::Tmask>& _masks, const std::vector<UVindices>& _inpainted_indices, std::vector<ocv::VecImg>& _disparities, const std::string& _directory_path) const;
+	/*! Checks that there are as many inpainted subapertures, masks and positions, and that images have light field dimensions.*/
+	static bool check_edits(const cv::Size& _image_size, const std::vector<ocv::Timg>& _inpainted_subapertures, const std::vector<ocv::Tmask>& _masks, const std::vector<UVindices>& _inpainted_indices);
+
+	/*! Initialize superpixel interpolation. Ie : compute interpolation weights in #sps_interpolation.
+	If \p _checkpoint is not null, weights or merged labels found in it are used instead of being computed, and computed ones are written in it.*/
+	void superpixel_interpolation_init(SPS& _sps, const ocv::Timg& _segmentation_image, const ocv::Tmask& _mask, const std::string& _write_path, InpaintingCheckpoint* _checkpoint = nullptr) const;
 };
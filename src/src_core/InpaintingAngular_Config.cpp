@@ -19,6 +19,7 @@ const std::map<ConfigParametersSpecializations<InpaintingAngular>::ParametersId,
 { sps_config_path, "sps_config_path" },
 { sps_merger_config_path, "sps_merger_config_path" },
 { sps_interpolation_config_path, "sps_interpolation_config_path" },
+{ checkpoint_path, "checkpoint_path" },
 };
 
 bool ConfigParametersSpecializations<InpaintingAngular>::set_value(InpaintingAngular::Parameters& _parameters, const std::string& _parameter_name, const std::vector<std::string>& _sub_strings, const std::string& _config_directory) {
@@ -60,6 +61,10 @@ bool ConfigParametersSpecializations<InpaintingAngular>::set_value(InpaintingAng
 		l_keep_reading = ConfigParameter::read(sps_interpolation_config_path, _sub_strings, _parameter_name);
 		l_keep_reading &= ConfigReader::read<SpsInterpolation>(_parameters.sps_interpolation_parameters, Misc::concat_path_and_filename(_config_directory, sps_interpolation_config_path));
 
+	} else if (_parameter_name == all_parameters.at(ParametersId::checkpoint_path)) {
+
+		l_keep_reading = ConfigParameter::read(_parameters.checkpoint_path, _sub_strings, _parameter_name);
+
 	}
 	else {
 		ConfigBase::display_unknown_parameter(_parameter_name);
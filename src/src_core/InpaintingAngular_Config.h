@@ -17,6 +17,7 @@ private:
 		sps_config_path,
 		sps_merger_config_path,
 		sps_interpolation_config_path,
+		checkpoint_path,
 	};
 	static const std::map<ParametersId, std::string> all_parameters;
 
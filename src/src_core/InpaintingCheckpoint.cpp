@@ -0,0 +1,316 @@
+/******************************************************************/
+/***            Pierre Allain, INRIA, February 2020				  */
+/***        GNU Affero General Public License version 3			  */
+/******************************************************************/
+
+#include "InpaintingCheckpoint.h"
+#include "misc_funcs.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+
+InpaintingCheckpoint::InpaintingCheckpoint() {}
+
+InpaintingCheckpoint::~InpaintingCheckpoint() {}
+
+const std::vector<std::string> InpaintingCheckpoint::file_names = { "key.txt", "views.txt", "labels.bin", "weights.bin", "disparities_raw.bin", "disparities.bin" };
+
+bool InpaintingCheckpoint::open(const std::string& _directory_path, const std::string& _key) {
+
+	directory_path.clear();
+	written_views.clear();
+
+	const std::string full_directory_path = Misc::to_data_path(_directory_path);
+	Misc::create_directory(_directory_path);
+	if (!Misc::is_directory(full_directory_path)) {
+		std::cout << "WARNING : Failed to create checkpoint directory " << full_directory_path << ". No checkpoint." << std::endl;
+		return false;
+	}
+
+	std::string key;
+	std::ifstream key_file(Misc::concat_path_and_filename(full_directory_path, "key.txt"));
+	if (key_file.is_open()) {
+		std::getline(key_file, key);
+		key_file.close();
+	} else if (Misc::count_directory_entries(full_directory_path) > 0) {
+		/*! Files of a checkpoint are only deleted in a checkpoint directory : user files are never touched.*/
+		std::cout << "WARNING : " << full_directory_path << " is not empty and is not a checkpoint directory. No checkpoint." << std::endl;
+		return false;
+	}
+	directory_path = full_directory_path;
+
+	if (key != _key) {
+		/*! Checkpoint of another job, or new one.*/
+		clear();
+		std::ofstream file(get_file_path("key.txt"));
+		file << _key << std::endl;
+	} else {
+		std::cout << "Resuming from checkpoint " << directory_path << std::endl;
+	}
+
+	std::ifstream views_file(get_file_path("views.txt"));
+	UIpair coordinates;
+	while (views_file >> coordinates.first >> coordinates.second) {
+		written_views.insert(coordinates);
+	}
+
+	return true;
+}
+
+void InpaintingCheckpoint::clear() {
+
+	written_views.clear();
+
+	if (is_open()) {
+		for (const std::string& file_name : file_names) {
+			std::remove(get_file_path(file_name).c_str());
+			std::remove(get_file_path(file_name + ".tmp").c_str());
+		}
+	}
+}
+
+bool InpaintingCheckpoint::is_open() const {
+
+	return !directory_path.empty();
+}
+
+bool InpaintingCheckpoint::write_labels(const cv::Mat& _labels) const {
+
+	return write_mats("labels.bin", { _labels });
+}
+
+bool InpaintingCheckpoint::read_labels(cv::Mat& _labels) const {
+
+	std::vector<cv::Mat> mats;
+	if (read_mats("labels.bin", mats) && mats.size() == 1 && mats[0].type() == CV_32SC1) {
+		_labels = mats[0];
+		return true;
+	} else {
+		return false;
+	}
+}
+
+bool InpaintingCheckpoint::write_weights(const SpsInterpolation::SparseWeights& _weights) const {
+
+	const int size[2] = { _weights.size.width, _weights.size.height };
+	return write_mats("weights.bin", { cv::Mat(1, 2, CV_32SC1, (void*)size), cv::Mat(_weights.pixels), cv::Mat(_weights.offsets), cv::Mat(_weights.indices), cv::Mat(_weights.values) });
+}
+
+bool InpaintingCheckpoint::read_weights(SpsInterpolation::SparseWeights& _weights) const {
+
+	std::vector<cv::Mat> mats;
+	if (!read_mats("weights.bin", mats) || mats.size() != 5 || mats[0].total() != 2 || mats[0].type() != CV_32SC1 || mats[2].type() != CV_32SC1
+		|| (mats[1].total() > 0 && mats[1].type() != CV_32SC1) || (mats[3].total() > 0 && mats[3].type() != CV_32SC1) || (mats[4].total() > 0 && mats[4].type() != CV_64FC1)) {
+		return false;
+	}
+
+	/*! Vectors are read as single columns : continuous.*/
+	_weights.size = cv::Size(mats[0].at<int>(0), mats[0].at<int>(1));
+	_weights.pixels.assign((const int*)mats[1].data, (const int*)mats[1].data + mats[1].total());
+	_weights.offsets.assign((const int*)mats[2].data, (const int*)mats[2].data + mats[2].total());
+	_weights.indices.assign((const int*)mats[3].data, (const int*)mats[3].data + mats[3].total());
+	_weights.values.assign((const double*)mats[4].data, (const double*)mats[4].data + mats[4].total());
+
+	if (!check_weights(_weights)) {
+		std::cout << "WARNING : Invalid checkpoint " << get_file_path("weights.bin") << std::endl;
+		return false;
+	}
+
+	return true;
+}
+
+bool InpaintingCheckpoint::check_weights(const SpsInterpolation::SparseWeights& _weights) {
+
+	if (_weights.size.width <= 0 || _weights.size.height <= 0 || (double)_weights.size.width * (double)_weights.size.height > (double)std::numeric_limits<int>::max()) {
+		return false;
+	}
+	const int area = _weights.size.area();
+
+	if (_weights.offsets.size() != _weights.pixels.size() + 1 || _weights.values.size() != _weights.indices.size()
+		|| _weights.offsets.front() != 0 || _weights.offsets.back() != (int)_weights.indices.size()) {
+		return false;
+	}
+
+	for (size_t r = 0; r < _weights.pixels.size(); r++) {
+		/*! Pixels in increasing order : each pixel has a single row.*/
+		if (_weights.pixels[r] < 0 || _weights.pixels[r] >= area || (r > 0 && _weights.pixels[r] <= _weights.pixels[r - 1])
+			|| _weights.offsets[r + 1] < _weights.offsets[r]) {
+			return false;
+		}
+	}
+
+	for (const int index : _weights.indices) {
+		if (index < 0 || index >= area) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool InpaintingCheckpoint::write_disparities(const ocv::VecImg& _disparities, const bool _l_interpolated) const {
+
+	return write_mats(_l_interpolated ? "disparities.bin" : "disparities_raw.bin", { _disparities.first, _disparities.second });
+}
+
+bool InpaintingCheckpoint::read_disparities(ocv::VecImg& _disparities, const bool _l_interpolated) const {
+
+	std::vector<cv::Mat> mats;
+	if (read_mats(_l_interpolated ? "disparities.bin" : "disparities_raw.bin", mats) && mats.size() == 2 && mats[0].type() == ocv::Timg1().type() && mats[1].type() == ocv::Timg1().type()) {
+		_disparities.first = mats[0];
+		_disparities.second = mats[1];
+		return true;
+	} else {
+		return false;
+	}
+}
+
+bool InpaintingCheckpoint::is_view_written(const UIpair& _coordinates, const std::string& _file_path) const {
+
+	/*! A view listed as written may have been moved or deleted since.*/
+	return written_views.count(_coordinates) > 0 && std::ifstream(Misc::to_data_path(_file_path)).good();
+}
+
+void InpaintingCheckpoint::add_written_view(const UIpair& _coordinates) {
+
+	if (is_open()) {
+		written_views.insert(_coordinates);
+		std::ofstream file(get_file_path("views.txt"), std::ios::app);
+		file << _coordinates.first << " " << _coordinates.second << std::endl;
+	}
+}
+
+std::string InpaintingCheckpoint::get_key(const std::vector<cv::Mat>& _images, const std::string& _description) {
+
+	/*! FNV-1a hash.*/
+	uint64_t hash = 14695981039346656037ull;
+	for (const cv::Mat& image : _images) {
+		const size_t row_size = image.cols * image.elemSize();
+		for (int y = 0; y < image.rows; y++) {
+			const uchar* data = image.ptr(y);
+			for (size_t i = 0; i < row_size; i++) {
+				hash ^= data[i];
+				hash *= 1099511628211ull;
+			}
+		}
+	}
+
+	std::ostringstream key;
+	key << std::hex << std::setw(16) << std::setfill('0') << hash << " | " << _description;
+	return key.str();
+}
+
+std::string InpaintingCheckpoint::get_file_path(const std::string& _file_name) const {
+
+	return Misc::concat_path_and_filename(directory_path, _file_name);
+}
+
+bool InpaintingCheckpoint::write_mats(const std::string& _file_name, const std::vector<cv::Mat>& _mats) const {
+
+	if (!is_open()) {
+		return false;
+	}
+
+	const std::string file_path = get_file_path(_file_name);
+	const std::string file_path_temporary = file_path + ".tmp";
+
+	{
+		std::ofstream file(file_path_temporary, std::ios::binary);
+
+		if (!file.is_open()) {
+			std::cout << "WARNING : Failed to write checkpoint " << file_path << std::endl;
+			return false;
+		}
+
+		Header header;
+		std::memcpy(header.magic, "FLCK", 4);
+		header.version = version;
+		header.Nmats = (uint32_t)_mats.size();
+		file.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+
+		for (const cv::Mat& mat : _mats) {
+			const int32_t dimensions[3] = { mat.rows, mat.cols, mat.type() };
+			file.write(reinterpret_cast<const char*>(dimensions), sizeof(dimensions));
+			/*! Matrices can be regions of interest : written row by row.*/
+			const size_t row_size = mat.cols * mat.elemSize();
+			for (int y = 0; y < mat.rows; y++) {
+				file.write(reinterpret_cast<const char*>(mat.ptr(y)), row_size);
+			}
+		}
+
+		if (!file) {
+			std::cout << "WARNING : Failed to write checkpoint " << file_path << std::endl;
+			return false;
+		}
+	}
+
+	/*! Renamed once complete : an interrupted writing leaves no checkpoint file.*/
+	return std::rename(file_path_temporary.c_str(), file_path.c_str()) == 0;
+}
+
+bool InpaintingCheckpoint::read_mats(const std::string& _file_name, std::vector<cv::Mat>& _mats) const {
+
+	if (!is_open()) {
+		return false;
+	}
+
+	const std::string file_path = get_file_path(_file_name);
+	std::ifstream file(file_path, std::ios::binary | std::ios::ate);
+
+	if (!file.is_open()) {
+		return false;
+	}
+
+	/*! Sizes read from file are bounded by file size : a corrupted file is rejected before anything is allocated.*/
+	const std::streamoff file_size = file.tellg();
+	file.seekg(0);
+
+	Header header;
+	file.read(reinterpret_cast<char*>(&header), sizeof(Header));
+	if (!file || std::memcmp(header.magic, "FLCK", 4) != 0 || header.version != version || header.Nmats > Nmats_max) {
+		std::cout << "WARNING : Invalid checkpoint " << file_path << std::endl;
+		return false;
+	}
+
+	_mats.clear();
+
+	try {
+
+		std::streamoff remaining_size = file_size - (std::streamoff)sizeof(Header);
+		for (uint32_t m = 0; m < header.Nmats; m++) {
+
+			int32_t dimensions[3];
+			file.read(reinterpret_cast<char*>(dimensions), sizeof(dimensions));
+			remaining_size -= (std::streamoff)sizeof(dimensions);
+
+			const int type = dimensions[2];
+			const bool l_valid_type = type == CV_MAT_TYPE(type) && CV_MAT_DEPTH(type) <= CV_64F;
+			if (!file || dimensions[0] < 0 || dimensions[1] < 0 || !l_valid_type
+				|| (double)dimensions[0] * (double)dimensions[1] * (double)CV_ELEM_SIZE(type) > (double)remaining_size) {
+				std::cout << "WARNING : Invalid checkpoint " << file_path << std::endl;
+				_mats.clear();
+				return false;
+			}
+
+			_mats.emplace_back(dimensions[0], dimensions[1], type);
+			cv::Mat& mat = _mats.back();
+			const std::streamoff mat_size = (std::streamoff)(mat.total() * mat.elemSize());
+			file.read(reinterpret_cast<char*>(mat.data), mat_size);
+			remaining_size -= mat_size;
+			if (!file) {
+				std::cout << "WARNING : Truncated checkpoint " << file_path << std::endl;
+				_mats.clear();
+				return false;
+			}
+		}
+
+	} catch (const std::exception& _exception) {
+		std::cout << "WARNING : Invalid checkpoint " << file_path << " : " << _exception.what() << std::endl;
+		_mats.clear();
+		return false;
+	}
+
+	return true;
+}
@@ -0,0 +1,96 @@
+/******************************************************************/
+/***            Pierre Allain, INRIA, February 2020				  */
+/***        GNU Affero General Public License version 3			  */
+/******************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <set>
+#include "SubaperturesData.h"
+#include "SpsInterpolation.h"
+
+/*! Checkpoint of an inpainting job in a directory : stage outputs of InpaintingAngular are written there once computed, so that a restarted job resumes from its last completed stage.
+Stages are merged superpixel labels, interpolation weights (compressed sparse rows, see SpsInterpolation::SparseWeights), disparities before and after interpolation inside mask,
+and list of views already written on disk.
+Files are binary, in native byte order : a list of matrices. A file is written under a temporary name and renamed once complete, so that a present file is always complete.
+A checkpoint is identified by the key of its job (see get_key) : a checkpoint of another job is cleared when opened. Only files of checkpoint are ever deleted,
+and a directory that is not empty and holds no checkpoint is refused.*/
+class InpaintingCheckpoint {
+
+	struct Header {
+		/*! "FLCK".*/
+		char magic[4];
+		uint32_t version;
+		uint32_t Nmats;
+	};
+
+	static const uint32_t version = 1;
+	/*! Bound of number of matrices of a file, checked when read.*/
+	static const uint32_t Nmats_max = 16;
+
+	/*! Files of a checkpoint, the only ones deleted by clear.*/
+	static const std::vector<std::string> file_names;
+
+	/*! Full path of checkpoint directory. Empty if not opened.*/
+	std::string directory_path;
+
+	/*! Writing coordinates of views already written (see Images4D::imwrite).*/
+	std::set<UIpair> written_views;
+
+public:
+	InpaintingCheckpoint();
+	~InpaintingCheckpoint();
+
+	/*! Opens checkpoint directory \p _directory_path, relative to data path, created if missing. If \p _key differs from the one of checkpoint, checkpoint is cleared and takes \p _key.
+	Returns false if directory can't be created, or if it is not empty and holds no checkpoint : nothing is then read nor written.*/
+	bool open(const std::string& _directory_path, const std::string& _key);
+	bool is_open() const;
+	/*! Deletes files of checkpoint, once its job is complete. Directory stays opened.*/
+	void clear();
+
+	/*! Merged superpixel labels.*/
+	bool write_labels(const cv::Mat& _labels) const;
+	bool read_labels(cv::Mat& _labels) const;
+	/*! Superpixel interpolation weights.*/
+	bool write_weights(const SpsInterpolation::SparseWeights& _weights) const;
+	bool read_weights(SpsInterpolation::SparseWeights& _weights) const;
+	/*! Disparities of light field if \p _l_interpolated is false, or disparities interpolated inside mask if true.*/
+	bool write_disparities(const ocv::VecImg& _disparities, const bool _l_interpolated) const;
+	bool read_disparities(ocv::VecImg& _disparities, const bool _l_interpolated) const;
+
+	/*! True if view is listed as written and its file \p _file_path, relative to data path, exists.*/
+	bool is_view_written(const UIpair& _coordinates, const std::string& _file_path) const;
+	/*! Adds a view to the list of written views. List file is appended at once.*/
+	void add_written_view(const UIpair& _coordinates);
+	/*! Writes views of \p _subapertures that are not already on disk (see Images4D::imwrite), each one being added to written views once written.*/
+	template <class Timg>
+	void imwrite(const SubaperturesData<Timg>& _subapertures, const std::string& _prefix, const typename Timg::value_type::value_type _range_min, const typename Timg::value_type::value_type _range_max);
+
+	/*! Key of a job : hash of values of \p _images, followed by \p _description.*/
+	static std::string get_key(const std::vector<cv::Mat>& _images, const std::string& _description);
+
+private:
+
+	std::string get_file_path(const std::string& _file_name) const;
+	/*! Checks that \p _weights can be set in an interpolation (see SpsInterpolation::set_weights) : rows, pixels and weight indices within image.*/
+	static bool check_weights(const SpsInterpolation::SparseWeights& _weights);
+	/*! Writes \p _mats in file \p _file_name of checkpoint directory.*/
+	bool write_mats(const std::string& _file_name, const std::vector<cv::Mat>& _mats) const;
+	/*! Reads \p _mats from file \p _file_name of checkpoint directory. Returns false if file is missing, invalid or corrupted.*/
+	bool read_mats(const std::string& _file_name, std::vector<cv::Mat>& _mats) const;
+};
+
+template <class Timg>
+void InpaintingCheckpoint::imwrite(const SubaperturesData<Timg>& _subapertures, const std::string& _prefix, const typename Timg::value_type::value_type _range_min, const typename Timg::value_type::value_type _range_max) {
+
+	if (!written_views.empty()) {
+		std::cout << written_views.size() << " views already written, according to checkpoint" << std::endl;
+	}
+
+	_subapertures.imwrite(_prefix, _range_min, _range_max, [this](const UIpair& _coordinates, const std::string& _file_path) {
+		return !is_view_written(_coordinates, _file_path);
+	}, [this](const UIpair& _coordinates) {
+		add_written_view(_coordinates);
+	});
+}
@@ -0,0 +1,149 @@
+/******************************************************************/
+/***            Pierre Allain, INRIA, February 2020				  */
+/***        GNU Affero General Public License version 3			  */
+/******************************************************************/
+
+#include "InpaintingSession.h"
+#include "ShiftSubapertures.h"
+#include "Profiler.h"
+
+InpaintingSession::InpaintingSession() : l_started(false) {}
+
+InpaintingSession::InpaintingSession(const InpaintingAngular::Parameters& _parameters) : l_started(false) {
+
+	set_parameters(_parameters);
+}
+
+InpaintingSession::~InpaintingSession() {}
+
+void InpaintingSession::set_parameters(const InpaintingAngular::Parameters& _parameters) {
+
+	stop();
+	inpainting.set_parameters(_parameters);
+}
+
+bool InpaintingSession::start(const SubaperturesData<>& _subapertures, const ocv::Timg& _inpainted_subaperture, const ocv::Tmask& _mask, const UVindices& _inpainted_indices, SubaperturesData<>& _subapertures_output, const std::string _directory_name) {
+
+	stop();
+	/*! Merged superpixels refer to mask image : a copy is used, so that caller can edit its mask in place.*/
+	const ocv::Tmask mask_start = _mask.clone();
+	inpainting.inpaint(_subapertures, _inpainted_subaperture, mask_start, _inpainted_indices, edit_cache, _subapertures_output, _directory_name);
+
+	return start(_inpainted_subaperture, _inpainted_indices);
+}
+
+bool InpaintingSession::start(const SubaperturesData<ocv::Timg8>& _subapertures, const ocv::Timg& _inpainted_subaperture, const ocv::Tmask& _mask, const UVindices& _inpainted_indices, SubaperturesData<ocv::Timg8>& _subapertures_output, const std::string _directory_name) {
+
+	stop();
+	/*! Merged superpixels refer to mask image : a copy is used, so that caller can edit its mask in place.*/
+	const ocv::Tmask mask_start = _mask.clone();
+	inpainting.inpaint(_subapertures, _inpainted_subaperture, mask_start, _inpainted_indices, edit_cache, _subapertures_output, _directory_name);
+
+	return start(_inpainted_subaperture, _inpainted_indices);
+}
+
+bool InpaintingSession::start(const ocv::Timg& _inpainted_subaperture, const UVindices& _inpainted_indices) {
+
+	/*! Cache is only complete if inpainting succeeded.*/
+	if (edit_cache.disparities && edit_cache.sps) {
+
+		inpainted_subaperture = _inpainted_subaperture.clone();
+		inpainted_indices = _inpainted_indices;
+		/*! Mask image is shared with merged superpixels, and never modified in place.*/
+		mask = edit_cache.sps->sps_merger.get_mask();
+		inpainting.interpolate_disparities(edit_cache, disparities);
+
+		l_started = true;
+
+	} else {
+		std::cout << "InpaintingSession : inpainting failed, session is not started." << std::endl;
+		stop();
+	}
+
+	return l_started;
+}
+
+bool InpaintingSession::update(const SubaperturesData<>& _subapertures, const ocv::Tmask& _mask, SubaperturesData<>& _subapertures_output) {
+
+	return update_subapertures(_subapertures, _mask, _subapertures_output);
+}
+
+bool InpaintingSession::update(const SubaperturesData<ocv::Timg8>& _subapertures, const ocv::Tmask& _mask, SubaperturesData<ocv::Timg8>& _subapertures_output) {
+
+	return update_subapertures(_subapertures, _mask, _subapertures_output);
+}
+
+template <class Timg>
+bool InpaintingSession::update_subapertures(const SubaperturesData<Timg>& _subapertures, const ocv::Tmask& _mask, SubaperturesData<Timg>& _subapertures_output) {
+
+	if (!l_started) {
+		std::cout << "InpaintingSession : session is not started." << std::endl;
+		return false;
+	}
+
+	if (_mask.size() != mask.size() || _subapertures.get_image_size() != mask.size() || _subapertures_output.get_image_size() != mask.size()
+		|| _subapertures_output.get_Nu() != _subapertures.get_Nu() || _subapertures_output.get_Nv() != _subapertures.get_Nv()) {
+		std::cout << "InpaintingSession : wrong dimensions." << std::endl;
+		std::cout << "Session mask size : " << mask.size() << std::endl;
+		std::cout << "Mask size : " << _mask.size() << std::endl;
+		std::cout << "Subapertures image size : " << _subapertures.get_image_size() << std::endl;
+		std::cout << "Output image size : " << _subapertures_output.get_image_size() << std::endl;
+		return false;
+	}
+
+	Profiler::Scope scope("update");
+
+	ocv::Tmask changed;
+	update_disparities(_mask, changed);
+
+	if (cv::countNonZero(changed)) {
+		Profiler::Scope scope("warp");
+		ShiftSubapertures<ocv::Timg>::warp_forward_tiles(_subapertures, disparities, inpainted_subaperture, mask, inpainted_indices, changed, _subapertures_output);
+	}
+
+	return true;
+}
+
+void InpaintingSession::update_disparities(const ocv::Tmask& _mask, ocv::Tmask& _changed) {
+
+	_changed = _mask != mask;
+
+	if (cv::countNonZero(_changed)) {
+
+		/*! New image : previous one is still referred to by merged superpixels until they are updated.*/
+		mask = _mask.clone();
+		inpainting.update_edit_cache(edit_cache, mask);
+
+		/*! Interpolation allocates new disparities : previous ones are kept for comparison.*/
+		const ocv::VecImg disparities_previous = disparities;
+		inpainting.interpolate_disparities(edit_cache, disparities);
+
+		_changed |= disparities.first != disparities_previous.first;
+		_changed |= disparities.second != disparities_previous.second;
+	}
+
+}
+
+bool InpaintingSession::is_started() const {
+
+	return l_started;
+}
+
+void InpaintingSession::stop() {
+
+	edit_cache = InpaintingAngular::EditCache();
+	inpainted_subaperture.release();
+	mask.release();
+	disparities = ocv::VecImg();
+	l_started = false;
+}
+
+const ocv::Tmask& InpaintingSession::get_mask() const {
+
+	return mask;
+}
+
+const ocv::VecImg& InpaintingSession::get_disparities() const {
+
+	return disparities;
+}
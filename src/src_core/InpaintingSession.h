@@ -0,0 +1,64 @@
+/******************************************************************/
+/***            Pierre Allain, INRIA, February 2020				  */
+/***        GNU Affero General Public License version 3			  */
+/******************************************************************/
+
+#pragma once
+
+#include "InpaintingAngular.h"
+
+/*! Interactive inpainting of a light field whose mask is edited step by step, for instance stroke by stroke in a painting tool.
+A session keeps superpixel segmentation, merged superpixels, interpolation weights and disparities of light field at inpainted position.
+An update of mask merges superpixels again, computes weights of changed superpixels only (see SpsInterpolation::update), and warps again only the tiles of views
+around pixels whose mask or disparity changed (see ShiftSubapertures::warp_forward_tiles).
+Inpainted subaperture is the same for the whole session : segmentation is computed on it once.*/
+class InpaintingSession {
+
+	InpaintingAngular inpainting;
+
+	/*! Intermediate results kept between updates. Superpixels are owned by session.*/
+	InpaintingAngular::EditCache edit_cache;
+	ocv::Timg inpainted_subaperture;
+	UVindices inpainted_indices;
+	/*! Mask of last update.*/
+	ocv::Tmask mask;
+	/*! Disparities of last update, interpolated inside #mask.*/
+	ocv::VecImg disparities;
+
+	bool l_started;
+
+public:
+	InpaintingSession();
+	InpaintingSession(const InpaintingAngular::Parameters& _parameters);
+	~InpaintingSession();
+
+	/*! Stops session.*/
+	void set_parameters(const InpaintingAngular::Parameters& _parameters);
+
+	/*! Starts session with a full inpainting of \p _subapertures in \p _subapertures_output (see InpaintingAngular::inpaint). Returns false if inpainting failed.*/
+	bool start(const SubaperturesData<>& _subapertures, const ocv::Timg& _inpainted_subaperture, const ocv::Tmask& _mask, const UVindices& _inpainted_indices, SubaperturesData<>& _subapertures_output, const std::string _directory_name = "");
+	bool start(const SubaperturesData<ocv::Timg8>& _subapertures, const ocv::Timg& _inpainted_subaperture, const ocv::Tmask& _mask, const UVindices& _inpainted_indices, SubaperturesData<ocv::Timg8>& _subapertures_output, const std::string _directory_name = "");
+
+	/*! Updates \p _subapertures_output, result of start or of last update with same \p _subapertures, for edited mask \p _mask (whole mask, not only its changes).
+	Returns false if session is not started or dimensions are wrong.*/
+	bool update(const SubaperturesData<>& _subapertures, const ocv::Tmask& _mask, SubaperturesData<>& _subapertures_output);
+	bool update(const SubaperturesData<ocv::Timg8>& _subapertures, const ocv::Tmask& _mask, SubaperturesData<ocv::Timg8>& _subapertures_output);
+
+	bool is_started() const;
+	/*! Releases intermediate results.*/
+	void stop();
+
+	const ocv::Tmask& get_mask() const;
+	const ocv::VecImg& get_disparities() const;
+
+private :
+
+	/*! Keeps inputs of start once #edit_cache is complete.*/
+	bool start(const ocv::Timg& _inpainted_subaperture, const UVindices& _inpainted_indices);
+
+	/*! Updates superpixels and disparities for \p _mask. \p _changed contains pixels whose mask or disparity changed.*/
+	void update_disparities(const ocv::Tmask& _mask, ocv::Tmask& _changed);
+
+	template <class Timg>
+	bool update_subapertures(const SubaperturesData<Timg>& _subapertures, const ocv::Tmask& _mask, SubaperturesData<Timg>& _subapertures_output);
+};
@@ -7,19 +7,22 @@
 
 #include "SubaperturesData.h"
 #include "Inpainting.h"
+#include "Tracing.h"
+#include <map>
 
 template <class Timg>
 class ShiftSubapertures {
 
-	static Timg white_image;
-	static ocv::Timg1 matissa_image;
-	static ocv::Timg1 disparity_mean_image_buff;
-	static ocv::Timg1 disparity_mean_image;
+	/*! Buffers are per thread, so that views can be warped concurrently.*/
+	static thread_local Timg white_image;
+	static thread_local ocv::Timg1 matissa_image;
+	static thread_local ocv::Timg1 disparity_mean_image_buff;
+	static thread_local ocv::Timg1 disparity_mean_image;
 	/*! For detection of zero weight values in image, so that they are not filled with inpainting.*/
-	static ocv::Tmask zero_values;
-	static cv::Mat_< cv::Vec<uchar, Timg::value_type::channels> > convert_image;
+	static thread_local ocv::Tmask zero_values;
+	static thread_local cv::Mat_< cv::Vec<uchar, Timg::value_type::channels> > convert_image;
 	/*! Assumption of likely pixels to be shifted inside real mask.*/
-	static ocv::Tmask image_mask_dilated;
+	static thread_local ocv::Tmask image_mask_dilated;
 
 public :
 	static void warp_backward(const SubaperturesData<Timg>& _subapertures_input, const ocv::VecImg& _disparities, const ocv::Timg& _central_image, const ocv::Tmask& _image_mask, const UVindices _central_image_indices, SubaperturesData<Timg>& _subapertures_output);
@@ -29,23 +32,51 @@ public :
 	static void warp_forward(const SubaperturesData<Timg>& _subapertures_input, const ocv::VecImg& _disparities, const ocv::Timg& _central_image, const ocv::Tmask& _image_mask, const UVindices _central_image_indices, SubaperturesData<Timg>& _subapertures_output);
 	static void warp_forward(const ocv::VecImg& _disparities, const ocv::Timg& _central_image, const UVindices _central_image_indices, const Fpair& _baseline_coef, SubaperturesData<Timg>& _subapertures_output);
 	static void warp_forward(const Timg& _image_input, const ocv::VecImg& _disparities, const Fpair& _baseline, const Fpair& _coef, Timg& _image_output, bool _l_disparity_mean=true, bool _l_inpaint_crack=true, const ocv::Tmask _image_mask=ocv::Tmask());
+	/*! Same as light field warp_forward, for views stored in another type (8 bits for instance). Only pixels of mask are modified by warping :
+	views are converted to Timg only inside the bounding box of mask, enlarged by #region_margin, and written back in their own type.*/
+	template <class Timg_storage>
+	static void warp_forward_region(const SubaperturesData<Timg_storage>& _subapertures_input, const ocv::VecImg& _disparities, const ocv::Timg& _central_image, const ocv::Tmask& _image_mask, const UVindices _central_image_indices, SubaperturesData<Timg_storage>& _subapertures_output);
+
+	/*! Light field warp_forward of several edits, each one with its \p _central_images, \p _image_masks, \p _central_images_indices and \p _disparities, in a single pass over views :
+	each view is copied once, then masked regions of every edit are warped into it, in edits order. At its own position, an edit only replaces pixels of its mask,
+	so that edits at a same position don't overwrite each other. Views are processed in parallel.*/
+	static void warp_forward(const SubaperturesData<Timg>& _subapertures_input, const std::vector<ocv::VecImg>& _disparities, const std::vector<ocv::Timg>& _central_images, const std::vector<ocv::Tmask>& _image_masks, const std::vector<UVindices>& _central_images_indices, SubaperturesData<Timg>& _subapertures_output);
+	/*! warp_forward_region of several edits, in a single pass over views (see multiple edits warp_forward).*/
+	template <class Timg_storage>
+	static void warp_forward_region(const SubaperturesData<Timg_storage>& _subapertures_input, const std::vector<ocv::VecImg>& _disparities, const std::vector<ocv::Timg>& _central_images, const std::vector<ocv::Tmask>& _image_masks, const std::vector<UVindices>& _central_images_indices, SubaperturesData<Timg_storage>& _subapertures_output);
+
+	/*! Warps again, in \p _subapertures_output holding a previous warp of \p _subapertures_input from \p _central_image, only the tiles of views where warp may differ :
+	tiles within margin of \p _changed pixels (pixels whose mask or disparity changed). Margin of a view is its largest displacement (largest disparity times angular offset) plus #region_margin.
+	Each tile is warped from input views on its region enlarged by margin, and only the tile is written. Views of type Timg_storage are converted to Timg inside regions only. View at \p _central_image_indices is left unchanged. Views are processed in parallel.*/
+	template <class Timg_storage>
+	static void warp_forward_tiles(const SubaperturesData<Timg_storage>& _subapertures_input, const ocv::VecImg& _disparities, const ocv::Timg& _central_image, const ocv::Tmask& _image_mask, const UVindices _central_image_indices, const ocv::Tmask& _changed, SubaperturesData<Timg_storage>& _subapertures_output);
+
+	/*! Margin in pixels around mask bounding box for warp_forward_region. Covers mask dilation of warp_forward (4) and neighbourhood of crack inpainting.*/
+	static const int region_margin = 8;
+	/*! Size in pixels of tiles of warp_forward_tiles.*/
+	static const int tile_size = 32;
+
+	/*! Angular view synthesis : same dimensions as SubaperturesData::get_refined, but \p _n_images views inserted between existing ones are warped from \p _central_image
+	with its \p _disparities (see DisparityFastGradient) instead of being left empty. Existing views are copied. Output uses contiguous storage, allocated once,
+	and every view is written once in its slot. Views are processed in parallel.*/
+	static void warp_refine(const SubaperturesData<Timg>& _subapertures_input, const ocv::VecImg& _disparities, const ocv::Timg& _central_image, const UVindices _central_image_indices, const Upair& _n_images, SubaperturesData<Timg>& _subapertures_output);
 
 };
 
 template <class Timg>
-Timg ShiftSubapertures<Timg>::white_image;
+thread_local Timg ShiftSubapertures<Timg>::white_image;
 template <class Timg>
-ocv::Timg1 ShiftSubapertures<Timg>::matissa_image;
+thread_local ocv::Timg1 ShiftSubapertures<Timg>::matissa_image;
 template <class Timg>
-ocv::Timg1 ShiftSubapertures<Timg>::disparity_mean_image_buff;
+thread_local ocv::Timg1 ShiftSubapertures<Timg>::disparity_mean_image_buff;
 template <class Timg>
-ocv::Timg1 ShiftSubapertures<Timg>::disparity_mean_image;
+thread_local ocv::Timg1 ShiftSubapertures<Timg>::disparity_mean_image;
 template <class Timg>
-ocv::Tmask ShiftSubapertures<Timg>::zero_values;
+thread_local ocv::Tmask ShiftSubapertures<Timg>::zero_values;
 template <class Timg>
-cv::Mat_< cv::Vec<uchar, Timg::value_type::channels> > ShiftSubapertures<Timg>::convert_image;
+thread_local cv::Mat_< cv::Vec<uchar, Timg::value_type::channels> > ShiftSubapertures<Timg>::convert_image;
 template <class Timg>
-ocv::Tmask ShiftSubapertures<Timg>::image_mask_dilated;
+thread_local ocv::Tmask ShiftSubapertures<Timg>::image_mask_dilated;
 
 template <class Timg>
 void ShiftSubapertures<Timg>::warp_backward(const SubaperturesData<Timg>& _subapertures_input, const ocv::VecImg& _disparities, const ocv::Timg& _central_image, const ocv::Tmask& _image_mask, const UVindices _central_image_indices, SubaperturesData<Timg>& _subapertures_output) {
@@ -93,6 +124,7 @@ void ShiftSubapertures<Timg>::warp_forward(const SubaperturesData<Timg>& _subape
 			offset.first *= -1;
 			offset.second *= -1;
 
+			Tracing::Scope scope("warp_forward", u, v);
 			warp_forward(_central_image, _disparities, _subapertures_input.get_baseline(), offset, _subapertures_output(u, v), true, true, _image_mask);
 			
 		}
@@ -127,6 +159,7 @@ void ShiftSubapertures<Timg>::warp_forward(const ocv::VecImg& _disparities, cons
 			offset.first *= -1;
 			offset.second *= -1;
 
+			Tracing::Scope scope("warp_forward", u, v);
 			warp_forward(_central_image, _disparities, _subapertures_output.get_baseline(), offset, _subapertures_output(u, v));
 
 		}
@@ -135,6 +168,357 @@ void ShiftSubapertures<Timg>::warp_forward(const ocv::VecImg& _disparities, cons
 
 }
 
+template <class Timg>
+template <class Timg_storage>
+void ShiftSubapertures<Timg>::warp_forward_region(const SubaperturesData<Timg_storage>& _subapertures_input, const ocv::VecImg& _disparities, const ocv::Timg& _central_image, const ocv::Tmask& _image_mask, const UVindices _central_image_indices, SubaperturesData<Timg_storage>& _subapertures_output) {
+
+	std::cout << "Warping supapertures" << std::endl;
+
+	_subapertures_input.copyTo(_subapertures_output);
+
+	/*! Central image values are in [0,1].*/
+	const ocv::Range<ocv::Tvalue> range_image((ocv::Tvalue)0., (ocv::Tvalue)1.);
+	ocv::convertTo(_central_image, _subapertures_output[_central_image_indices], range_image);
+
+	std::vector<cv::Point> mask_points;
+	cv::findNonZero(_image_mask == ocv::mask_value, mask_points);
+
+	if (mask_points.empty()) {
+		return;
+	}
+
+	cv::Rect region = cv::boundingRect(mask_points);
+	region -= cv::Point(region_margin, region_margin);
+	region += cv::Size(2 * region_margin, 2 * region_margin);
+	region &= cv::Rect(cv::Point(0, 0), _image_mask.size());
+
+	/*! Continuous copies of region, as warp_forward iterates on whole images.*/
+	const ocv::Timg central_region = _central_image(region).clone();
+	const ocv::VecImg disparities_region(_disparities.first(region).clone(), _disparities.second(region).clone());
+	const ocv::Tmask mask_region = _image_mask(region).clone();
+
+	Timg view_region;
+	Fpair offset;
+
+	for (unsigned int u = 0; u < _subapertures_input.get_Nu(); u++) {
+		for (unsigned int v = 0; v < _subapertures_input.get_Nv(); v++) {
+
+			offset.first = u;
+			offset.first -= _central_image_indices.first;
+			offset.second = v;
+			offset.second -= _central_image_indices.second;
+
+			offset.first *= -1;
+			offset.second *= -1;
+
+			Tracing::Scope scope("warp_forward", u, v);
+			/*! Header on output view : converted region is written in place.*/
+			Timg_storage view_output = _subapertures_output(u, v)(region);
+			ocv::convertTo(view_output, view_region, true);
+			warp_forward(central_region, disparities_region, _subapertures_input.get_baseline(), offset, view_region, true, true, mask_region);
+			ocv::convertTo(view_region, view_output, range_image);
+
+		}
+		Misc::display_progression(u, _subapertures_input.get_Nu());
+	}
+
+}
+
+template <class Timg>
+void ShiftSubapertures<Timg>::warp_forward(const SubaperturesData<Timg>& _subapertures_input, const std::vector<ocv::VecImg>& _disparities, const std::vector<ocv::Timg>& _central_images, const std::vector<ocv::Tmask>& _image_masks, const std::vector<UVindices>& _central_images_indices, SubaperturesData<Timg>& _subapertures_output) {
+
+	std::cout << "Warping supapertures (" << _central_images.size() << " edits)" << std::endl;
+
+	_subapertures_input.copyTo(_subapertures_output);
+
+	const unsigned int Nv = _subapertures_input.get_Nv();
+
+	/*! Views are independent : warp buffers are per thread, and each view is written by a single thread.*/
+	cv::parallel_for_(cv::Range(0, int(_subapertures_input.get_Nu() * Nv)), [&](const cv::Range& _range) {
+		for (int i = _range.start; i < _range.end; i++) {
+
+			const unsigned int u = i / Nv;
+			const unsigned int v = i % Nv;
+
+			Tracing::Scope scope("warp_forward", u, v);
+
+			for (unsigned int e = 0; e < _central_images.size(); e++) {
+
+				if (UVindices(u, v) == _central_images_indices[e]) {
+
+					_central_images[e].copyTo(_subapertures_output(u, v), _image_masks[e] == ocv::mask_value);
+
+				} else {
+
+					Fpair offset;
+					offset.first = u;
+					offset.first -= _central_images_indices[e].first;
+					offset.second = v;
+					offset.second -= _central_images_indices[e].second;
+
+					offset.first *= -1;
+					offset.second *= -1;
+
+					warp_forward(_central_images[e], _disparities[e], _subapertures_input.get_baseline(), offset, _subapertures_output(u, v), true, true, _image_masks[e]);
+				}
+			}
+		}
+	});
+
+}
+
+template <class Timg>
+template <class Timg_storage>
+void ShiftSubapertures<Timg>::warp_forward_region(const SubaperturesData<Timg_storage>& _subapertures_input, const std::vector<ocv::VecImg>& _disparities, const std::vector<ocv::Timg>& _central_images, const std::vector<ocv::Tmask>& _image_masks, const std::vector<UVindices>& _central_images_indices, SubaperturesData<Timg_storage>& _subapertures_output) {
+
+	std::cout << "Warping supapertures (" << _central_images.size() << " edits)" << std::endl;
+
+	_subapertures_input.copyTo(_subapertures_output);
+
+	/*! Central image values are in [0,1].*/
+	const ocv::Range<ocv::Tvalue> range_image((ocv::Tvalue)0., (ocv::Tvalue)1.);
+
+	/*! Continuous copies of region of each edit, as warp_forward iterates on whole images.*/
+	struct Region {
+		cv::Rect rect;
+		ocv::Timg central_image;
+		ocv::VecImg disparities;
+		ocv::Tmask mask;
+	};
+	std::vector<Region> regions;
+	/*! Edits indices of regions.*/
+	std::vector<unsigned int> edits;
+
+	for (unsigned int e = 0; e < _central_images.size(); e++) {
+
+		std::vector<cv::Point> mask_points;
+		cv::findNonZero(_image_masks[e] == ocv::mask_value, mask_points);
+
+		if (!mask_points.empty()) {
+
+			Region region;
+			region.rect = cv::boundingRect(mask_points);
+			region.rect -= cv::Point(region_margin, region_margin);
+			region.rect += cv::Size(2 * region_margin, 2 * region_margin);
+			region.rect &= cv::Rect(cv::Point(0, 0), _image_masks[e].size());
+
+			region.central_image = _central_images[e](region.rect).clone();
+			region.disparities = ocv::VecImg(_disparities[e].first(region.rect).clone(), _disparities[e].second(region.rect).clone());
+			region.mask = _image_masks[e](region.rect).clone();
+
+			regions.push_back(region);
+			edits.push_back(e);
+		}
+	}
+
+	const unsigned int Nv = _subapertures_input.get_Nv();
+
+	cv::parallel_for_(cv::Range(0, int(_subapertures_input.get_Nu() * Nv)), [&](const cv::Range& _range) {
+
+		Timg view_region;
+		Timg_storage central_region;
+
+		for (int i = _range.start; i < _range.end; i++) {
+
+			const unsigned int u = i / Nv;
+			const unsigned int v = i % Nv;
+
+			Tracing::Scope scope("warp_forward", u, v);
+
+			for (unsigned int r = 0; r < regions.size(); r++) {
+
+				const Region& region = regions[r];
+				const UVindices& central_image_indices = _central_images_indices[edits[r]];
+				/*! Header on output view : converted region is written in place.*/
+				Timg_storage view_output = _subapertures_output(u, v)(region.rect);
+
+				if (UVindices(u, v) == central_image_indices) {
+
+					ocv::convertTo(region.central_image, central_region, range_image);
+					central_region.copyTo(view_output, region.mask == ocv::mask_value);
+
+				} else {
+
+					Fpair offset;
+					offset.first = u;
+					offset.first -= central_image_indices.first;
+					offset.second = v;
+					offset.second -= central_image_indices.second;
+
+					offset.first *= -1;
+					offset.second *= -1;
+
+					ocv::convertTo(view_output, view_region, true);
+					warp_forward(region.central_image, region.disparities, _subapertures_input.get_baseline(), offset, view_region, true, true, region.mask);
+					ocv::convertTo(view_region, view_output, range_image);
+				}
+			}
+		}
+	});
+
+}
+
+template <class Timg>
+template <class Timg_storage>
+void ShiftSubapertures<Timg>::warp_forward_tiles(const SubaperturesData<Timg_storage>& _subapertures_input, const ocv::VecImg& _disparities, const ocv::Timg& _central_image, const ocv::Tmask& _image_mask, const UVindices _central_image_indices, const ocv::Tmask& _changed, SubaperturesData<Timg_storage>& _subapertures_output) {
+
+	const cv::Rect image_rect(cv::Point(0, 0), _image_mask.size());
+
+	/*! Largest displacement per unit of angular offset : a warped pixel comes from a pixel up to this distance away times offset of view.*/
+	cv::Point2d disparity_max;
+	double disparity_min_value, disparity_max_value;
+	cv::minMaxLoc(_disparities.first, &disparity_min_value, &disparity_max_value);
+	disparity_max.x = std::max(std::abs(disparity_min_value), std::abs(disparity_max_value));
+	cv::minMaxLoc(_disparities.second, &disparity_min_value, &disparity_max_value);
+	disparity_max.y = std::max(std::abs(disparity_min_value), std::abs(disparity_max_value));
+
+	/*! Margin of each view : changed pixels alter warped pixels up to displacement + region_margin away, and a tile is warped from pixels up to this distance.*/
+	const unsigned int Nv = _subapertures_input.get_Nv();
+	std::vector<int> margins(_subapertures_input.get_Nu() * Nv);
+	for (unsigned int u = 0; u < _subapertures_input.get_Nu(); u++) {
+		for (unsigned int v = 0; v < Nv; v++) {
+			const double displacement = std::max(disparity_max.x * std::abs((double)u - (double)_central_image_indices.first), disparity_max.y * std::abs((double)v - (double)_central_image_indices.second));
+			margins[u * Nv + v] = (int)std::ceil(displacement) + region_margin;
+		}
+	}
+
+	/*! Tiles and their enlarged region. Views with same margin share tiles.*/
+	struct Region {
+		cv::Rect tile;
+		cv::Rect rect;
+	};
+	std::map<int, std::vector<Region> > regions;
+	size_t Ntiles = 0;
+
+	for (int margin : margins) {
+
+		if (regions.count(margin)) {
+			continue;
+		}
+
+		std::vector<Region>& margin_regions = regions[margin];
+
+		ocv::Tmask changed_dilated;
+		cv::dilate(_changed, changed_dilated, cv::Mat(), cv::Point(-1, -1), margin);
+
+		for (int y = 0; y < image_rect.height; y += tile_size) {
+			for (int x = 0; x < image_rect.width; x += tile_size) {
+
+				Region region;
+				region.tile = cv::Rect(x, y, tile_size, tile_size) & image_rect;
+
+				if (cv::countNonZero(changed_dilated(region.tile))) {
+
+					region.rect = region.tile;
+					region.rect -= cv::Point(margin, margin);
+					region.rect += cv::Size(2 * margin, 2 * margin);
+					region.rect &= image_rect;
+
+					margin_regions.push_back(region);
+				}
+			}
+		}
+		Ntiles = std::max(Ntiles, margin_regions.size());
+	}
+
+	std::cout << "Warping supapertures (up to " << Ntiles << " tiles)" << std::endl;
+
+	/*! Central image values are in [0,1].*/
+	const ocv::Range<ocv::Tvalue> range_image((ocv::Tvalue)0., (ocv::Tvalue)1.);
+	/*! Natural range of views values.*/
+	const ocv::Range<typename Timg_storage::value_type::value_type> range_storage = ocv::get_minmax_range<typename Timg_storage::value_type::value_type>();
+
+	cv::parallel_for_(cv::Range(0, int(_subapertures_input.get_Nu() * Nv)), [&](const cv::Range& _range) {
+
+		Timg view_region;
+		/*! Continuous copies of region, as warp_forward iterates on whole images.*/
+		ocv::Timg central_region;
+		ocv::VecImg disparities_region;
+		ocv::Tmask mask_region;
+
+		for (int i = _range.start; i < _range.end; i++) {
+
+			const unsigned int u = i / Nv;
+			const unsigned int v = i % Nv;
+
+			/*! Central view is the central image, whatever the mask.*/
+			if (UVindices(u, v) == _central_image_indices) {
+				continue;
+			}
+
+			Fpair offset;
+			offset.first = u;
+			offset.first -= _central_image_indices.first;
+			offset.second = v;
+			offset.second -= _central_image_indices.second;
+
+			offset.first *= -1;
+			offset.second *= -1;
+
+			Tracing::Scope scope("warp_forward", u, v);
+
+			for (const Region& region : regions.at(margins[i])) {
+
+				_central_image(region.rect).copyTo(central_region);
+				_disparities.first(region.rect).copyTo(disparities_region.first);
+				_disparities.second(region.rect).copyTo(disparities_region.second);
+				_image_mask(region.rect).copyTo(mask_region);
+
+				/*! Warp starts from input view, so that pixels no longer masked get back their input values.*/
+				ocv::convertTo(_subapertures_input(u, v)(region.rect), view_region, range_storage);
+				warp_forward(central_region, disparities_region, _subapertures_input.get_baseline(), offset, view_region, true, true, mask_region);
+				/*! Header on output view : tile is written in place.*/
+				Timg_storage view_output = _subapertures_output(u, v)(region.tile);
+				ocv::convertTo(view_region(region.tile - region.rect.tl()), view_output, range_image);
+			}
+		}
+	});
+
+}
+
+template <class Timg>
+void ShiftSubapertures<Timg>::warp_refine(const SubaperturesData<Timg>& _subapertures_input, const ocv::VecImg& _disparities, const ocv::Timg& _central_image, const UVindices _central_image_indices, const Upair& _n_images, SubaperturesData<Timg>& _subapertures_output) {
+
+	std::cout << "Synthesizing subapertures" << std::endl;
+
+	const unsigned int Nu = _subapertures_input.get_Nu() + (_subapertures_input.get_Nu() - 1) * _n_images.first;
+	const unsigned int Nv = _subapertures_input.get_Nv() + (_subapertures_input.get_Nv() - 1) * _n_images.second;
+	const unsigned int step_u = _n_images.first + 1;
+	const unsigned int step_v = _n_images.second + 1;
+
+	_subapertures_input.copyPropertiesTo(_subapertures_output);
+	_subapertures_output.resize_contiguous(Nu, Nv, _central_image.size());
+
+	/*! Views are independent : warp buffers are per thread, and each slot is written by a single thread.*/
+	cv::parallel_for_(cv::Range(0, int(Nu * Nv)), [&](const cv::Range& _range) {
+		for (int i = _range.start; i < _range.end; i++) {
+
+			const unsigned int u = i / Nv;
+			const unsigned int v = i % Nv;
+
+			if (u % step_u == 0 && v % step_v == 0 && ocv::is_valid(_subapertures_input(u / step_u, v / step_v))) {
+
+				_subapertures_input(u / step_u, v / step_v).copyTo(_subapertures_output(u, v));
+
+			} else {
+
+				/*! Angular position in units of input views, as in light field warp_forward.*/
+				Fpair offset;
+				offset.first = float(u) / float(step_u);
+				offset.first -= _central_image_indices.first;
+				offset.second = float(v) / float(step_v);
+				offset.second -= _central_image_indices.second;
+
+				offset.first *= -1;
+				offset.second *= -1;
+
+				Tracing::Scope scope("warp_refine", u, v);
+				warp_forward(_central_image, _disparities, _subapertures_input.get_baseline(), offset, _subapertures_output(u, v));
+			}
+		}
+	});
+
+}
 
 template <class Tlist, class Titerator>
 cv::Point iterator_to_coordinates(const Titerator& _iterator,const unsigned int _width, const Tlist& _list) {
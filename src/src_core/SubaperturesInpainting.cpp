@@ -4,6 +4,9 @@
 /******************************************************************/
 
 #include "SubaperturesInpainting.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <cmath>
 
 const std::string SubaperturesInpainting::directory_name() {
 	static const std::string _directory_name_ = "Inpainting";
@@ -28,10 +31,183 @@ const SubaperturesInpainting::Parameters& SubaperturesInpainting::get_parameters
 	return parameters;
 }
 
+void SubaperturesInpainting::set_preview_function(const std::function<void(const SubaperturesData<>&)>& _preview_function) {
+
+	preview_function = _preview_function;
+}
+
+void SubaperturesInpainting::set_preview_function(const std::function<void(const SubaperturesData<ocv::Timg8>&)>& _preview_function) {
+
+	preview_function_8bit = _preview_function;
+}
+
+bool SubaperturesInpainting::has_preview_function(const SubaperturesData<>&) const {
+
+	return (bool)preview_function;
+}
+
+bool SubaperturesInpainting::has_preview_function(const SubaperturesData<ocv::Timg8>&) const {
+
+	return (bool)preview_function_8bit;
+}
+
+void SubaperturesInpainting::call_preview_function(const SubaperturesData<>& _subapertures_preview) const {
+
+	if (preview_function) {
+		preview_function(_subapertures_preview);
+	}
+}
+
+void SubaperturesInpainting::call_preview_function(const SubaperturesData<ocv::Timg8>& _subapertures_preview) const {
+
+	if (preview_function_8bit) {
+		preview_function_8bit(_subapertures_preview);
+	}
+}
+
+InpaintingAngular::Parameters SubaperturesInpainting::get_preview_parameters() const {
+
+	InpaintingAngular::Parameters preview_parameters = parameters.inpainting_angular_parameters;
+	const double scale = parameters.preview_scale;
+
+	/*! Disparities are expressed in pixels.*/
+	preview_parameters.disparity_fast_gradient_parameters.disparity_bound *= ocv::Tvalue(scale);
+	/*! Same number of superpixels as at full resolution, with the same minimum known area.*/
+	preview_parameters.sps_parameters.Nsuperpixels_per_pixel /= scale * scale;
+	preview_parameters.sps_merger_parameters.Nknown_pixels_min = std::max((unsigned int)std::lround(preview_parameters.sps_merger_parameters.Nknown_pixels_min * scale * scale), 1u);
+
+	return preview_parameters;
+}
+
 void SubaperturesInpainting::inpaint(const SubaperturesData<>& _subapertures, SubaperturesData<>& _subapertures_output, const std::string _directory_name) const {
 
+	inpaint_subapertures(_subapertures, _subapertures_output, _directory_name);
+}
+
+void SubaperturesInpainting::inpaint(const SubaperturesData<ocv::Timg8>& _subapertures, SubaperturesData<ocv::Timg8>& _subapertures_output, const std::string _directory_name) const {
+
+	inpaint_subapertures(_subapertures, _subapertures_output, _directory_name);
+}
+
+void SubaperturesInpainting::inpaint(const SubaperturesData<>& _subapertures, InpaintingAngular::EditCache& _edit_cache, SubaperturesData<>& _subapertures_output, const std::string _directory_name) const {
+
+	inpaint_subapertures(_subapertures, _subapertures_output, _directory_name, &_edit_cache);
+}
+
+void SubaperturesInpainting::inpaint(const SubaperturesData<ocv::Timg8>& _subapertures, InpaintingAngular::EditCache& _edit_cache, SubaperturesData<ocv::Timg8>& _subapertures_output, const std::string _directory_name) const {
+
+	inpaint_subapertures(_subapertures, _subapertures_output, _directory_name, &_edit_cache);
+}
+
+void SubaperturesInpainting::inpaint(const SubaperturesData<>& _subapertures, const ocv::Timg& _inpainted_subaperture, const ocv::Tmask& _mask, SubaperturesData<>& _subapertures_output, const std::string _directory_name) const {
+
+	std::cout << "Light Field inpainting" << std::endl;
+
+	Profiler::Scope scope("inpaint");
+	inpaint_images(_subapertures, _inpainted_subaperture, _mask, _subapertures_output, _directory_name);
+}
+
+void SubaperturesInpainting::inpaint(const SubaperturesData<ocv::Timg8>& _subapertures, const ocv::Timg& _inpainted_subaperture, const ocv::Tmask& _mask, SubaperturesData<ocv::Timg8>& _subapertures_output, const std::string _directory_name) const {
+
+	std::cout << "Light Field inpainting" << std::endl;
+
+	Profiler::Scope scope("inpaint");
+	inpaint_images(_subapertures, _inpainted_subaperture, _mask, _subapertures_output, _directory_name);
+}
+
+void SubaperturesInpainting::inpaint(const SubaperturesData<>& _subapertures, const ocv::Timg& _inpainted_subaperture, const ocv::Tmask& _mask, InpaintingAngular::EditCache& _edit_cache, SubaperturesData<>& _subapertures_output, const std::string _directory_name) const {
+
+	std::cout << "Light Field inpainting" << std::endl;
+
+	Profiler::Scope scope("inpaint");
+	inpaint_images(_subapertures, _inpainted_subaperture, _mask, _subapertures_output, _directory_name, &_edit_cache);
+}
+
+void SubaperturesInpainting::inpaint(const SubaperturesData<ocv::Timg8>& _subapertures, const ocv::Timg& _inpainted_subaperture, const ocv::Tmask& _mask, InpaintingAngular::EditCache& _edit_cache, SubaperturesData<ocv::Timg8>& _subapertures_output, const std::string _directory_name) const {
+
 	std::cout << "Light Field inpainting" << std::endl;
 
+	Profiler::Scope scope("inpaint");
+	inpaint_images(_subapertures, _inpainted_subaperture, _mask, _subapertures_output, _directory_name, &_edit_cache);
+}
+
+std::string SubaperturesInpainting::get_checkpoint_key(const SubaperturesData<>& _subapertures) const {
+
+	return get_checkpoint_key_impl(_subapertures);
+}
+
+std::string SubaperturesInpainting::get_checkpoint_key(const SubaperturesData<ocv::Timg8>& _subapertures) const {
+
+	return get_checkpoint_key_impl(_subapertures);
+}
+
+template <class Timg>
+std::string SubaperturesInpainting::get_checkpoint_key_impl(const SubaperturesData<Timg>& _subapertures) const {
+
+	if (parameters.inpainting_angular_parameters.checkpoint_path.empty()) {
+		return "";
+	}
+
+	ocv::Timg inpainted_image;
+	ocv::Tmask mask;
+	read_images(inpainted_image, mask);
+
+	InpaintingAngular inpainting;
+	inpainting.set_parameters(parameters.inpainting_angular_parameters);
+	return inpainting.get_checkpoint_key(_subapertures, inpainted_image, mask, parameters.subaperture_position);
+}
+
+void SubaperturesInpainting::read_images(ocv::Timg& _inpainted_subaperture, ocv::Tmask& _mask) const {
+
+	if (!parameters.inpainted_subaperture_path.empty()) {
+		ocv::imread(parameters.inpainted_subaperture_path, _inpainted_subaperture);
+	}
+
+	if (!parameters.mask_path.empty()) {
+		ocv::imread(parameters.mask_path, _mask);
+		/*! Applies threshold to mask so values are either 0 or ocv::mask_value*/
+		ocv::mask_filter(_mask);
+	}
+}
+
+SubaperturesInpainting::Edit SubaperturesInpainting::get_edit() const {
+
+	Edit edit;
+	edit.inpainted_subaperture_path = parameters.inpainted_subaperture_path;
+	edit.subaperture_position = parameters.subaperture_position;
+	edit.mask_path = parameters.mask_path;
+	return edit;
+}
+
+void SubaperturesInpainting::inpaint(const SubaperturesData<>& _subapertures, const std::vector<Edit>& _edits, SubaperturesData<>& _subapertures_output, const std::string _directory_name) const {
+
+	inpaint_subapertures(_subapertures, _edits, _subapertures_output, _directory_name);
+}
+
+void SubaperturesInpainting::inpaint(const SubaperturesData<ocv::Timg8>& _subapertures, const std::vector<Edit>& _edits, SubaperturesData<ocv::Timg8>& _subapertures_output, const std::string _directory_name) const {
+
+	inpaint_subapertures(_subapertures, _edits, _subapertures_output, _directory_name);
+}
+
+template <class Timg>
+void SubaperturesInpainting::inpaint_subapertures(const SubaperturesData<Timg>& _subapertures, SubaperturesData<Timg>& _subapertures_output, const std::string _directory_name, InpaintingAngular::EditCache* _edit_cache) const {
+
+	std::cout << "Light Field inpainting" << std::endl;
+
+	Profiler::Scope scope("inpaint");
+
+	/*! Read inpainted subaperture and mask.*/
+	ocv::Timg inpainted_image;
+	ocv::Tmask mask;
+	read_images(inpainted_image, mask);
+
+	inpaint_images(_subapertures, inpainted_image, mask, _subapertures_output, _directory_name, _edit_cache);
+
+}
+
+template <class Timg>
+void SubaperturesInpainting::inpaint_images(const SubaperturesData<Timg>& _subapertures, const ocv::Timg& _inpainted_subaperture, const ocv::Tmask& _mask, SubaperturesData<Timg>& _subapertures_output, const std::string _directory_name, InpaintingAngular::EditCache* _edit_cache) const {
+
 	std::string directory_name_up = _directory_name;
 	if (directory_name_up.empty()) {
 		directory_name_up = _subapertures.get_name();
@@ -41,36 +217,48 @@ void SubaperturesInpainting::inpaint(const SubaperturesData<>& _subapertures, Su
 
 	if (_subapertures.check_uv_indices(parameters.subaperture_position)) {
 
+		if (_mask.size() == _subapertures.get_image_size()) {
 
 
-		/*! Read inpainted subaperture and mask.*/
-		ocv::Timg inpainted_image;
-		if (!parameters.inpainted_subaperture_path.empty()) {
-			ocv::imread(parameters.inpainted_subaperture_path, inpainted_image);
-		}
-
-		ocv::Tmask mask;
-		if (!parameters.mask_path.empty()) {
-			ocv::imread(parameters.mask_path, mask);
-			/*! Applies threshold to mask so values are either 0 or ocv::mask_value*/
-			ocv::mask_filter(mask);
-		}
-
-		if (mask.size() == _subapertures.get_image_size()) {
+			int count_masked = cv::countNonZero(_mask == ocv::mask_value);
+			std::cout << "Mask ratio = " << float(count_masked) / float(_mask.total()) * 100. << " %" << std::endl;
 
+			/*! Checkpoint is only used by inpainting without edit cache : it has priority over preview. Preview is only computed for a caller receiving it.*/
+			const bool l_preview = parameters.preview_scale > 0.f && parameters.inpainting_angular_parameters.checkpoint_path.empty() && has_preview_function(_subapertures);
+			if (parameters.preview_scale > 0.f && !parameters.inpainting_angular_parameters.checkpoint_path.empty()) {
+				std::cout << "WARNING : No preview when checkpoint is used." << std::endl;
+			}
 
-			int count_masked = cv::countNonZero(mask == ocv::mask_value);
-			std::cout << "Mask ratio = " << float(count_masked) / float(mask.total()) * 100. << " %" << std::endl;
+			/*! Full resolution inpainting reuses upsampled disparities of preview through a local edit cache, sharing members of caller's one if any :
+			upsampled disparities never reach caller's cache.*/
+			InpaintingAngular::EditCache edit_cache_preview;
+			InpaintingAngular::EditCache* edit_cache = _edit_cache;
+			if (l_preview) {
+				if (_edit_cache) {
+					edit_cache_preview = *_edit_cache;
+				}
+				edit_cache = &edit_cache_preview;
+				inpaint_preview(_subapertures, _inpainted_subaperture, _mask, edit_cache_preview, directory_path);
+			}
 
 			InpaintingAngular inpainting;
 			inpainting.set_parameters(parameters.inpainting_angular_parameters);
-			inpainting.inpaint(_subapertures, inpainted_image, mask, parameters.subaperture_position, _subapertures_output, directory_path);
+			if (edit_cache) {
+				inpainting.inpaint(_subapertures, _inpainted_subaperture, _mask, parameters.subaperture_position, *edit_cache, _subapertures_output, directory_path);
+			} else {
+				inpainting.inpaint(_subapertures, _inpainted_subaperture, _mask, parameters.subaperture_position, _subapertures_output, directory_path);
+			}
+
+			/*! Superpixels are computed at full resolution : they are given back to caller.*/
+			if (l_preview && _edit_cache && !_edit_cache->sps) {
+				_edit_cache->sps = edit_cache_preview.sps;
+			}
 
 		} else {
 			std::cout << "SubaperturesInpainting : wrong image dimension." << std::endl;
 			std::cout << "Subapertures image size : " << _subapertures.get_image_size() << std::endl;
-			std::cout << "Inpainted image size : " << inpainted_image.size() << std::endl;
-			std::cout << "Mask image size : " << mask.size() << std::endl;
+			std::cout << "Inpainted image size : " << _inpainted_subaperture.size() << std::endl;
+			std::cout << "Mask image size : " << _mask.size() << std::endl;
 		}
 
 	} else {
@@ -82,3 +270,110 @@ void SubaperturesInpainting::inpaint(const SubaperturesData<>& _subapertures, Su
 
 }
 
+template <class Timg>
+void SubaperturesInpainting::inpaint_preview(const SubaperturesData<Timg>& _subapertures, const ocv::Timg& _inpainted_subaperture, const ocv::Tmask& _mask, InpaintingAngular::EditCache& _edit_cache, const std::string& _directory_path) const {
+
+	Profiler::Scope scope("preview");
+
+	const double scale = parameters.preview_scale;
+	const cv::Size image_size = _subapertures.get_image_size();
+	const cv::Size preview_size(std::max(int(std::lround(image_size.width * scale)), 1), std::max(int(std::lround(image_size.height * scale)), 1));
+
+	std::cout << "Preview at scale " << scale << " : " << preview_size << std::endl;
+
+	/*! Same scale along both axes : baseline ratio is unchanged.*/
+	SubaperturesData<Timg> subapertures_preview;
+	_subapertures.copyPropertiesTo(subapertures_preview);
+
+	const unsigned int Nv = _subapertures.get_Nv();
+	cv::parallel_for_(cv::Range(0, int(_subapertures.get_Nu() * Nv)), [&](const cv::Range& _range) {
+		for (int i = _range.start; i < _range.end; i++) {
+			const Timg& view = _subapertures(i / Nv, i % Nv);
+			if (ocv::is_valid(view)) {
+				cv::resize(view, subapertures_preview(i / Nv, i % Nv), preview_size, 0, 0, cv::INTER_AREA);
+			}
+		}
+	});
+
+	ocv::Timg inpainted_preview;
+	cv::resize(_inpainted_subaperture, inpainted_preview, preview_size, 0, 0, cv::INTER_AREA);
+
+	/*! A preview pixel is masked as soon as one of its pixels is.*/
+	ocv::Tmask mask_preview;
+	cv::resize(_mask, mask_preview, preview_size, 0, 0, cv::INTER_AREA);
+	mask_preview.setTo(ocv::mask_value, mask_preview > 0);
+
+	InpaintingAngular::EditCache edit_cache;
+	SubaperturesData<Timg> subapertures_preview_output;
+	{
+		InpaintingAngular inpainting;
+		inpainting.set_parameters(get_preview_parameters());
+		inpainting.inpaint(subapertures_preview, inpainted_preview, mask_preview, parameters.subaperture_position, edit_cache, subapertures_preview_output, Misc::concat_paths(_directory_path, "Preview"));
+	}
+	subapertures_preview.clear();
+
+	std::cout << "Preview duration : " << Profiler::to_string_duration(scope.elapsed()) << std::endl;
+	call_preview_function(subapertures_preview_output);
+
+	if (!_edit_cache.disparities && edit_cache.disparities) {
+
+		Profiler::Scope scope("upsampling");
+
+		/*! Raw disparities are upsampled, and interpolated inside full resolution mask by full resolution superpixels. Disparities are expressed in pixels.*/
+		_edit_cache.disparities = std::make_shared<ocv::VecImg>();
+		cv::resize(edit_cache.disparities->first, _edit_cache.disparities->first, image_size, 0, 0, cv::INTER_LINEAR);
+		cv::resize(edit_cache.disparities->second, _edit_cache.disparities->second, image_size, 0, 0, cv::INTER_LINEAR);
+		_edit_cache.disparities->first.convertTo(_edit_cache.disparities->first, -1, 1. / scale);
+		_edit_cache.disparities->second.convertTo(_edit_cache.disparities->second, -1, 1. / scale);
+	}
+
+}
+
+template <class Timg>
+void SubaperturesInpainting::inpaint_subapertures(const SubaperturesData<Timg>& _subapertures, const std::vector<Edit>& _edits, SubaperturesData<Timg>& _subapertures_output, const std::string _directory_name) const {
+
+	std::cout << "Light Field inpainting : " << _edits.size() << " edits" << std::endl;
+
+	Profiler::Scope scope("inpaint");
+
+	std::string directory_name_up = _directory_name;
+	if (directory_name_up.empty()) {
+		directory_name_up = _subapertures.get_name();
+	}
+	const std::string directory_path = Misc::concat_paths(directory_name_up, directory_name());
+
+	std::vector<ocv::Timg> inpainted_images(_edits.size());
+	std::vector<ocv::Tmask> masks(_edits.size());
+	std::vector<UVindices> positions(_edits.size());
+
+	/*! Read inpainted subapertures and masks.*/
+	for (unsigned int e = 0; e < _edits.size(); e++) {
+
+		if (!_subapertures.check_uv_indices(_edits[e].subaperture_position)) {
+			std::cout << "SubaperturesInpainting::inpaint : subaperture_position of edit " << e << " is out of range for the light field." << std::endl;
+			return;
+		}
+		positions[e] = _edits[e].subaperture_position;
+
+		if (!_edits[e].inpainted_subaperture_path.empty()) {
+			ocv::imread(_edits[e].inpainted_subaperture_path, inpainted_images[e]);
+		}
+
+		if (!_edits[e].mask_path.empty()) {
+			ocv::imread(_edits[e].mask_path, masks[e]);
+			/*! Applies threshold to mask so values are either 0 or ocv::mask_value*/
+			ocv::mask_filter(masks[e]);
+		}
+
+		if (masks[e].size() == _subapertures.get_image_size()) {
+			int count_masked = cv::countNonZero(masks[e] == ocv::mask_value);
+			std::cout << "Mask ratio of edit " << e << " = " << float(count_masked) / float(masks[e].total()) * 100. << " %" << std::endl;
+		}
+	}
+
+	/*! Dimensions are checked by InpaintingAngular.*/
+	InpaintingAngular inpainting;
+	inpainting.set_parameters(parameters.inpainting_angular_parameters);
+	inpainting.inpaint(_subapertures, inpainted_images, masks, positions, _subapertures_output, directory_path);
+
+}
@@ -5,6 +5,7 @@
 
 #pragma once
 
+#include <functional>
 #include "Typedefs.h"
 #include "SubaperturesData.h"
 #include "InpaintingAngular.h"
@@ -25,13 +26,28 @@ public :
 		std::string mask_path = "";
 		/*! Parameters of epipolar inpainting. Used if inpainting_type is set to total.*/
 		InpaintingAngular::Parameters inpainting_angular_parameters;
+		/*! Scale of progressive preview, in ]0, 1[ (ex : 0.25). Inpainting is first run on light field, inpainted subaperture and mask downscaled by this factor,
+		and the preview light field is given to preview function (see set_preview_function). Full resolution inpainting then uses upsampled disparities of preview,
+		which are not stored in caller's edit cache. No preview if 0, or if no preview function is set.*/
+		float preview_scale = 0.f;
 
 	};
 
+	/*! Independent edit of a light field. Same meaning as corresponding members of Parameters.*/
+	struct Edit {
+		std::string inpainted_subaperture_path = "";
+		UVindices subaperture_position = { (unsigned int)4, (unsigned int)4 };
+		std::string mask_path = "";
+	};
+
 private :
 
 	Parameters parameters;
 
+	/*! Called with preview light field, see Parameters::preview_scale.*/
+	std::function<void(const SubaperturesData<>&)> preview_function;
+	std::function<void(const SubaperturesData<ocv::Timg8>&)> preview_function_8bit;
+
 public :
 
 	SubaperturesInpainting();
@@ -40,6 +56,62 @@ public :
 	void set_parameters(const Parameters& _parameters);
 	const Parameters& get_parameters() const;
 
+	/*! Function receiving preview light field, before full resolution inpainting starts.*/
+	void set_preview_function(const std::function<void(const SubaperturesData<>&)>& _preview_function);
+	void set_preview_function(const std::function<void(const SubaperturesData<ocv::Timg8>&)>& _preview_function);
+
 	void inpaint(const SubaperturesData<>& _subapertures, SubaperturesData<>& _subapertures_output, const std::string _directory_name="") const;
+	/*! Inpainting of a light field stored in 8 bits. Floating point conversions are restricted to what is needed by computations.*/
+	void inpaint(const SubaperturesData<ocv::Timg8>& _subapertures, SubaperturesData<ocv::Timg8>& _subapertures_output, const std::string _directory_name="") const;
+
+	/*! Same as inpaint, reusing and completing disparities and superpixel weights of \p _edit_cache (see InpaintingAngular::EditCache).*/
+	void inpaint(const SubaperturesData<>& _subapertures, InpaintingAngular::EditCache& _edit_cache, SubaperturesData<>& _subapertures_output, const std::string _directory_name = "") const;
+	void inpaint(const SubaperturesData<ocv::Timg8>& _subapertures, InpaintingAngular::EditCache& _edit_cache, SubaperturesData<ocv::Timg8>& _subapertures_output, const std::string _directory_name = "") const;
+
+	/*! Same as inpaint, with inpainted subaperture and mask given as images instead of read from parameters paths. Mask values must be either 0 or ocv::mask_value (see ocv::mask_filter).
+	Convenient for callers holding images in memory : nothing is read from disk.*/
+	void inpaint(const SubaperturesData<>& _subapertures, const ocv::Timg& _inpainted_subaperture, const ocv::Tmask& _mask, SubaperturesData<>& _subapertures_output, const std::string _directory_name = "") const;
+	void inpaint(const SubaperturesData<ocv::Timg8>& _subapertures, const ocv::Timg& _inpainted_subaperture, const ocv::Tmask& _mask, SubaperturesData<ocv::Timg8>& _subapertures_output, const std::string _directory_name = "") const;
+	/*! Same as inpaint with images given by caller, reusing and completing \p _edit_cache.*/
+	void inpaint(const SubaperturesData<>& _subapertures, const ocv::Timg& _inpainted_subaperture, const ocv::Tmask& _mask, InpaintingAngular::EditCache& _edit_cache, SubaperturesData<>& _subapertures_output, const std::string _directory_name = "") const;
+	void inpaint(const SubaperturesData<ocv::Timg8>& _subapertures, const ocv::Timg& _inpainted_subaperture, const ocv::Tmask& _mask, InpaintingAngular::EditCache& _edit_cache, SubaperturesData<ocv::Timg8>& _subapertures_output, const std::string _directory_name = "") const;
+
+	/*! Reads inpainted subaperture and mask of parameters paths.*/
+	void read_images(ocv::Timg& _inpainted_subaperture, ocv::Tmask& _mask) const;
+
+	/*! Key of checkpoint of inpainting described by parameters (see InpaintingAngular::Parameters::checkpoint_path). Empty if no checkpoint is used.*/
+	std::string get_checkpoint_key(const SubaperturesData<>& _subapertures) const;
+	std::string get_checkpoint_key(const SubaperturesData<ocv::Timg8>& _subapertures) const;
+
+	/*! Edit described by parameters.*/
+	Edit get_edit() const;
+	/*! Several edits of a light field in one pass, each one with its own mask, inpainted subaperture and position. Disparity of light field is computed once per position,
+	and every view is warped once with all edits (see InpaintingAngular). Edits are applied in order.*/
+	void inpaint(const SubaperturesData<>& _subapertures, const std::vector<Edit>& _edits, SubaperturesData<>& _subapertures_output, const std::string _directory_name = "") const;
+	void inpaint(const SubaperturesData<ocv::Timg8>& _subapertures, const std::vector<Edit>& _edits, SubaperturesData<ocv::Timg8>& _subapertures_output, const std::string _directory_name = "") const;
+
+private :
+
+	template <class Timg>
+	std::string get_checkpoint_key_impl(const SubaperturesData<Timg>& _subapertures) const;
+	/*! \p _edit_cache is used if not null.*/
+	template <class Timg>
+	void inpaint_subapertures(const SubaperturesData<Timg>& _subapertures, SubaperturesData<Timg>& _subapertures_output, const std::string _directory_name, InpaintingAngular::EditCache* _edit_cache = nullptr) const;
+	/*! Inpainting with images read by caller. \p _edit_cache is used if not null.*/
+	template <class Timg>
+	void inpaint_images(const SubaperturesData<Timg>& _subapertures, const ocv::Timg& _inpainted_subaperture, const ocv::Tmask& _mask, SubaperturesData<Timg>& _subapertures_output, const std::string _directory_name, InpaintingAngular::EditCache* _edit_cache = nullptr) const;
+	/*! Inpainting of light field, inpainted subaperture and mask downscaled by Parameters::preview_scale. The preview light field is given to preview function,
+	and upsampled disparities of preview are stored in \p _edit_cache if it has none : \p _edit_cache must not be caller's one.*/
+	template <class Timg>
+	void inpaint_preview(const SubaperturesData<Timg>& _subapertures, const ocv::Timg& _inpainted_subaperture, const ocv::Tmask& _mask, InpaintingAngular::EditCache& _edit_cache, const std::string& _directory_path) const;
+	/*! Inpainting parameters at preview scale : parameters expressed in pixels follow image scale.*/
+	InpaintingAngular::Parameters get_preview_parameters() const;
+	/*! Whether a preview function is set for light fields of type of \p _subapertures.*/
+	bool has_preview_function(const SubaperturesData<>& _subapertures) const;
+	bool has_preview_function(const SubaperturesData<ocv::Timg8>& _subapertures) const;
+	void call_preview_function(const SubaperturesData<>& _subapertures_preview) const;
+	void call_preview_function(const SubaperturesData<ocv::Timg8>& _subapertures_preview) const;
+	template <class Timg>
+	void inpaint_subapertures(const SubaperturesData<Timg>& _subapertures, const std::vector<Edit>& _edits, SubaperturesData<Timg>& _subapertures_output, const std::string _directory_name) const;
 
 };
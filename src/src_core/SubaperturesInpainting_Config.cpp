@@ -15,6 +15,7 @@ const std::map<ConfigParametersSpecializations<SubaperturesInpainting>::Paramete
 { subaperture_position, "subaperture_position" },
 { mask_path, "mask_path" },
 { inpainting_config_path, "inpainting_config_path" },
+{ preview_scale, "preview_scale" },
 };
 
 bool ConfigParametersSpecializations<SubaperturesInpainting>::set_value(SubaperturesInpainting::Parameters& _parameters, const std::string& _parameter_name, const std::vector<std::string>& _sub_strings, const std::string& _config_directory) {
@@ -46,6 +47,11 @@ bool ConfigParametersSpecializations<SubaperturesInpainting>::set_value(Subapert
 		l_keep_reading &= ConfigReader::read<InpaintingAngular>(_parameters.inpainting_angular_parameters, Misc::concat_path_and_filename(_config_directory, inpainting_config_path));
 		
 
+	}
+	else if (_parameter_name == all_parameters.at(ParametersId::preview_scale)) {
+
+		l_keep_reading = ConfigParameter::read(_parameters.preview_scale, _sub_strings, _parameter_name);
+
 	}
 	else {
 		ConfigBase::display_unknown_parameter(_parameter_name);
@@ -57,6 +63,10 @@ bool ConfigParametersSpecializations<SubaperturesInpainting>::set_value(Subapert
 
 void ConfigParametersSpecializations<SubaperturesInpainting>::deduce_values(SubaperturesInpainting::Parameters& _parameters) {
 
+	if (_parameters.preview_scale < 0.f || _parameters.preview_scale >= 1.f) {
+		std::cout << "WARNING : preview_scale must be in ]0, 1[. Preview is disabled." << std::endl;
+		_parameters.preview_scale = 0.f;
+	}
 }
 
 void ConfigParametersSpecializations<SubaperturesInpainting>::error_message() {
@@ -16,6 +16,7 @@ private:
 		subaperture_position,
 		mask_path,
 		inpainting_config_path,
+		preview_scale,
 	};
 	static const std::map<ParametersId, std::string> all_parameters;
 
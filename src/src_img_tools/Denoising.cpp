@@ -42,7 +42,155 @@ std::string Denoising::get_method_name() const {
 		method_name = Misc::concat_paths(directory_name(), "NLMeansMulti");
 	} else if (parameters.denoising_type == Denoising::DenoisingType::NLMeansColoredMulti) {
 		method_name = Misc::concat_paths(directory_name(), "NLMeansColoredMulti");
+	} else if (parameters.denoising_type == Denoising::DenoisingType::TVL1Float) {
+		method_name = Misc::concat_paths(directory_name(), "TVL1Float");
 	}
 
 	return method_name;
 }
+
+unsigned int Denoising::solveTVL1(ocv::Timg1& _image, const ocv::Tmask& _mask, BufferTVL1& _buffer, const double _lambda, const unsigned int _Niterations, const double _tolerance) {
+
+	if (_image.empty() || _Niterations == 0) {
+		return 0;
+	}
+
+	const bool l_mask = !_mask.empty();
+
+	/*! Computation is restricted to the bounding box of the mask, with a one pixel margin.*/
+	cv::Rect roi(0, 0, _image.cols, _image.rows);
+	if (l_mask) {
+		if (!ocv::check_images_size(_image, _mask)) {
+			return 0;
+		}
+		roi = cv::boundingRect(_mask);
+		if (roi.area() == 0) {
+			return 0;
+		}
+		roi = cv::Rect(roi.x - 1, roi.y - 1, roi.width + 2, roi.height + 2) & cv::Rect(0, 0, _image.cols, _image.rows);
+		_mask(roi).copyTo(_buffer.mask);
+	}
+
+	_image(roi).copyTo(_buffer.observation);
+	_buffer.observation.copyTo(_buffer.primal);
+	_buffer.observation.copyTo(_buffer.primal_bar);
+	_buffer.dual_x.create(roi.size());
+	_buffer.dual_x = ocv::Tvec1::all(0.);
+	_buffer.dual_y.create(roi.size());
+	_buffer.dual_y = ocv::Tvec1::all(0.);
+
+	const int Nrows = roi.height;
+	const int Ncols = roi.width;
+	_buffer.zero_row.assign(Ncols, 0.f);
+	_buffer.rows_variation.assign(Nrows, 0.);
+
+	/*! Convergence criterion is relative to the range of the observation.*/
+	double value_min, value_max;
+	cv::minMaxLoc(_buffer.observation, &value_min, &value_max);
+	const double range = value_max - value_min;
+	if (range <= 0.) {
+		return 0;
+	}
+
+	/*! Same steps as cv::denoise_TVL1 so that lambda and iterations keep their meaning. tau*sigma*L^2 = 1, L^2 = 8.*/
+	const float tau = 0.02f;
+	const float sigma = 1.f / (8.f * tau);
+	const float tau_lambda = tau * float(_lambda);
+
+	unsigned int iteration = 0;
+	bool l_converged = false;
+
+	while (iteration < _Niterations && !l_converged) {
+
+		/*! Dual ascent : p = projection on unit ball of (p + sigma * gradient(primal_bar)). Forward differences, Neumann boundary.*/
+		cv::parallel_for_(cv::Range(0, Nrows), [&](const cv::Range& _range) {
+
+			for (int y = _range.start; y < _range.end; y++) {
+
+				const float* u = (const float*)_buffer.primal_bar.ptr(y);
+				/*! Last row has a null vertical gradient.*/
+				const float* u_next = (const float*)_buffer.primal_bar.ptr(std::min(y + 1, Nrows - 1));
+				float* px = (float*)_buffer.dual_x.ptr(y);
+				float* py = (float*)_buffer.dual_y.ptr(y);
+
+				for (int x = 0; x < Ncols - 1; x++) {
+					const float qx = px[x] + sigma * (u[x + 1] - u[x]);
+					const float qy = py[x] + sigma * (u_next[x] - u[x]);
+					const float norm = std::max(1.f, std::sqrt(qx * qx + qy * qy));
+					px[x] = qx / norm;
+					py[x] = qy / norm;
+				}
+				/*! Last column has a null horizontal gradient.*/
+				const int x = Ncols - 1;
+				const float qy = py[x] + sigma * (u_next[x] - u[x]);
+				px[x] = 0.f;
+				py[x] = qy / std::max(1.f, std::abs(qy));
+			}
+
+		});
+
+		/*! Primal descent : u = prox of tau*lambda*|u-f| applied to (u + tau * divergence(p)). Then extrapolation.*/
+		cv::parallel_for_(cv::Range(0, Nrows), [&](const cv::Range& _range) {
+
+			for (int y = _range.start; y < _range.end; y++) {
+
+				const float* f = (const float*)_buffer.observation.ptr(y);
+				const float* px = (const float*)_buffer.dual_x.ptr(y);
+				const float* py = (const float*)_buffer.dual_y.ptr(y);
+				const float* py_previous = (y > 0) ? (const float*)_buffer.dual_y.ptr(y - 1) : _buffer.zero_row.data();
+				float* u = (float*)_buffer.primal.ptr(y);
+				float* u_bar = (float*)_buffer.primal_bar.ptr(y);
+
+				double variation = 0.;
+
+				/*! First column, divergence with null previous horizontal dual.*/
+				{
+					const float u_old = u[0];
+					const float v = u_old + tau * (px[0] + py[0] - py_previous[0]);
+					const float u_new = v - std::max(-tau_lambda, std::min(v - f[0], tau_lambda));
+					u[0] = u_new;
+					u_bar[0] = 2.f * u_new - u_old;
+					variation += std::abs(u_new - u_old);
+				}
+				for (int x = 1; x < Ncols; x++) {
+					const float u_old = u[x];
+					const float v = u_old + tau * (px[x] - px[x - 1] + py[x] - py_previous[x]);
+					const float u_new = v - std::max(-tau_lambda, std::min(v - f[x], tau_lambda));
+					u[x] = u_new;
+					u_bar[x] = 2.f * u_new - u_old;
+					variation += std::abs(u_new - u_old);
+				}
+
+				/*! Pixels outside region of interest stay equal to the observation.*/
+				if (l_mask) {
+					const uchar* m = _buffer.mask.ptr(y);
+					for (int x = 0; x < Ncols; x++) {
+						if (!m[x]) {
+							variation -= std::abs(u[x] - f[x]);
+							u[x] = f[x];
+							u_bar[x] = f[x];
+						}
+					}
+				}
+
+				_buffer.rows_variation[y] = variation;
+			}
+
+		});
+
+		iteration++;
+
+		if (_tolerance > 0.) {
+			/*! Sequential sum over rows so that result does not depend on threads.*/
+			double variation = 0.;
+			for (int y = 0; y < Nrows; y++) {
+				variation += _buffer.rows_variation[y];
+			}
+			l_converged = (variation / (double(Nrows) * Ncols * range) < _tolerance);
+		}
+	}
+
+	_buffer.primal.copyTo(_image(roi));
+
+	return iteration;
+}
\ No newline at end of file
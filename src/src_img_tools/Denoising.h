@@ -14,7 +14,7 @@ public :
 
 	static const std::string directory_name();
 
-	enum DenoisingType { TVL1, NLMeans, NLMeansColored, NLMeansMulti, NLMeansColoredMulti};
+	enum DenoisingType { TVL1, NLMeans, NLMeansColored, NLMeansMulti, NLMeansColoredMulti, TVL1Float};
 
 	struct Parameters {
 		/*! Type of image denoising.*/
@@ -23,6 +23,8 @@ public :
 		double lambda = 0.5;
 		/*! TVL1 : Number of iterations for denoising.*/
 		unsigned int Niterations = 10;
+		/*! TVL1Float : Mean variation of the solution between two iterations, relative to input range, under which iterations stop. 0 means #Niterations are always run.*/
+		double tolerance = 0.;
 		/*! All NLMeans : Parameter regulating filter strength. Big h value perfectly removes noise but also removes image details, smaller h value preserves details but also preserves some noise*/
 		float h;
 		/*! All NLMeans : Size in pixels of the template patch that is used to compute weights. Should be odd. Recommended value 7 pixels.*/
@@ -39,6 +41,18 @@ public :
 
 
 
+	/*! Buffer of the floating point TVL1 solver. Used for a single channel.*/
+	struct BufferTVL1 {
+		ocv::Timg1 observation;
+		ocv::Timg1 primal;
+		ocv::Timg1 primal_bar;
+		ocv::Timg1 dual_x;
+		ocv::Timg1 dual_y;
+		ocv::Tmask mask;
+		std::vector<float> zero_row;
+		std::vector<double> rows_variation;
+	};
+
 	template <int Dim>
 	struct Buffer {
 		cv::Mat_< cv::Vec<uchar, Dim> > image_converted;
@@ -49,12 +63,20 @@ public :
 		std::vector< cv::Mat_< cv::Vec<uchar, Dim> > > images_denoised;
 		std::vector< std::vector< cv::Mat_< cv::Vec<uchar, 1> > > > splits_vector_input;
 		std::vector< std::vector< cv::Mat_< cv::Vec<uchar, 1> > > > splits_vector_output;
+		/*! TVL1Float buffers.*/
+		cv::Mat_< cv::Vec<float, Dim> > image_float;
+		std::vector< cv::Mat_< cv::Vec<float, 1> > > splits_float;
+		BufferTVL1 buffer_tvl1;
 	};
 
 private:
 
 	Parameters parameters;
 
+	/*! Primal-dual (Chambolle-Pock) resolution of TVL1 on a floating point image, in place. Rows are processed in parallel.
+	Pixels outside non empty \p _mask are kept unchanged. Returns number of iterations run.*/
+	static unsigned int solveTVL1(ocv::Timg1& _image, const ocv::Tmask& _mask, BufferTVL1& _buffer, const double _lambda, const unsigned int _Niterations, const double _tolerance);
+
 public:
 	Denoising();
 	Denoising(const Parameters& _parameters);
@@ -68,6 +90,9 @@ public:
 	//*! Denoise an image. Algorithms need 8bits images and can generate loss.*/
 	template <class Tvalue, int Dim>
 	void denoise(const cv::Mat_< cv::Vec<Tvalue, Dim> >& _input, cv::Mat_< cv::Vec<Tvalue, Dim> >& _output, Buffer<Dim>& _buffer);
+	/*! Denoise an image within a region of interest \p _mask (whole image if empty). Mask only applies to TVL1Float.*/
+	template <class Tvalue, int Dim>
+	void denoise(const cv::Mat_< cv::Vec<Tvalue, Dim> >& _input, const ocv::Tmask& _mask, cv::Mat_< cv::Vec<Tvalue, Dim> >& _output, Buffer<Dim>& _buffer);
 	/*! Denoise vector of images to obtain a denoised single one.*/
 	template <class Tvalue, int Dim>
 	void denoise(const std::vector< cv::Mat_< cv::Vec<Tvalue, Dim> > >& _inputs, cv::Mat_< cv::Vec<Tvalue, Dim> >& _output, Buffer<Dim>& _buffer);
@@ -83,6 +108,9 @@ public:
 	static void denoiseTVL1(const cv::Mat_< cv::Vec<Tvalue, Dim> >& _input, cv::Mat_< cv::Vec<Tvalue, Dim> >& _output, const double _lambda = 0.5, const unsigned int _Niterations = 100);
 	template <class Tvalue, int Dim>
 	static void denoiseTVL1(const cv::Mat_< cv::Vec<Tvalue, Dim> >& _input, cv::Mat_< cv::Vec<Tvalue, Dim> >& _output, Buffer<Dim>& _buffer, const double _lambda=0.5, const unsigned int _Niterations=100);
+	/*! Static case for floating point TVL1 : no 8bits quantization. Stops before \p _Niterations if \p _tolerance is reached. Optional region of interest \p _mask.*/
+	template <class Tvalue, int Dim>
+	static void denoiseTVL1Float(const cv::Mat_< cv::Vec<Tvalue, Dim> >& _input, cv::Mat_< cv::Vec<Tvalue, Dim> >& _output, Buffer<Dim>& _buffer, const double _lambda = 0.5, const unsigned int _Niterations = 100, const double _tolerance = 0., const ocv::Tmask& _mask = ocv::Tmask());
 
 };
 
@@ -12,6 +12,7 @@ const std::map<ConfigParametersSpecializations<Denoising>::ParametersId, std::st
 	{ denoising_type, "denoising_type" },
 { lambda, "lambda" },
 { Niterations, "Niterations" },
+{ tolerance, "tolerance" },
 { h, "h" },
 { templateWindowSize, "templateWindowSize" },
 { searchWindowSize, "searchWindowSize" },
@@ -35,6 +36,10 @@ bool ConfigParametersSpecializations<Denoising>::set_value(Denoising::Parameters
 
 		l_keep_reading = ConfigParameter::read(_parameters.Niterations, _sub_strings, _parameter_name);
 
+	} else if (_parameter_name == all_parameters.at(ParametersId::tolerance)) {
+
+		l_keep_reading = ConfigParameter::read(_parameters.tolerance, _sub_strings, _parameter_name);
+
 	} else if (_parameter_name == all_parameters.at(ParametersId::h)) {
 
 		l_keep_reading = ConfigParameter::read(_parameters.h, _sub_strings, _parameter_name);
@@ -15,6 +15,7 @@ private:
 		denoising_type,
 		lambda,
 		Niterations,
+		tolerance,
 		h,
 		templateWindowSize,
 		searchWindowSize,
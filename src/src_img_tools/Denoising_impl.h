@@ -11,9 +11,33 @@
 template <class Tvalue, int Dim>
 void Denoising::denoise(const cv::Mat_< cv::Vec<Tvalue, Dim> >& _input, cv::Mat_< cv::Vec<Tvalue, Dim> >& _output, Buffer<Dim>& _buffer) {
 
+	denoise(_input, ocv::Tmask(), _output, _buffer);
+}
+
+template <class Tvalue, int Dim>
+void Denoising::denoise(const cv::Mat_< cv::Vec<Tvalue, Dim> >& _input, const ocv::Tmask& _mask, cv::Mat_< cv::Vec<Tvalue, Dim> >& _output, Buffer<Dim>& _buffer) {
+
 	if (Misc::l_verbose_low) std::cout << "Denoising" << std::endl;
 
-	if (parameters.denoising_type == DenoisingType::TVL1 || parameters.denoising_type == DenoisingType::NLMeans || parameters.denoising_type == DenoisingType::NLMeansColored) {
+	if (parameters.denoising_type == DenoisingType::TVL1Float) {
+
+		/*! Convert input image to float, no quantization.*/
+		ocv::convertTo(_input, _buffer.image_float, false);
+
+		if (parameters.Niterations > 0) {
+
+			cv::split(_buffer.image_float, _buffer.splits_float);
+			for (unsigned int d = 0; d < Dim; d++) {
+				unsigned int Niterations = solveTVL1(_buffer.splits_float[d], _mask, _buffer.buffer_tvl1, parameters.lambda, parameters.Niterations, parameters.tolerance);
+				if (Misc::l_verbose_high) std::cout << "TVL1Float : " << Niterations << " iterations" << std::endl;
+			}
+			cv::merge(_buffer.splits_float, _buffer.image_float);
+		}
+
+		/*! Convert back to original type.*/
+		ocv::convertTo(_buffer.image_float, _output, false);
+
+	} else if (parameters.denoising_type == DenoisingType::TVL1 || parameters.denoising_type == DenoisingType::NLMeans || parameters.denoising_type == DenoisingType::NLMeansColored) {
 
 		if (Dim == 3 || parameters.denoising_type != DenoisingType::NLMeansColored) {
 
@@ -237,4 +261,20 @@ void Denoising::denoiseTVL1(const cv::Mat_< cv::Vec<Tvalue, Dim> >& _input, cv::
 
 	denoising.denoise(_input, _output, _buffer);
 
+}
+
+template <class Tvalue, int Dim>
+void Denoising::denoiseTVL1Float(const cv::Mat_< cv::Vec<Tvalue, Dim> >& _input, cv::Mat_< cv::Vec<Tvalue, Dim> >& _output, Buffer<Dim>& _buffer, const double _lambda, const unsigned int _Niterations, const double _tolerance, const ocv::Tmask& _mask) {
+
+	Parameters parameters;
+	parameters.denoising_type = DenoisingType::TVL1Float;
+	parameters.lambda = _lambda;
+	parameters.Niterations = _Niterations;
+	parameters.tolerance = _tolerance;
+
+	Denoising denoising;
+	denoising.set_parameters(parameters);
+
+	denoising.denoise(_input, _mask, _output, _buffer);
+
 }
\ No newline at end of file
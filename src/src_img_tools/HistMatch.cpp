@@ -110,3 +110,115 @@ void HistMatch::do1ChnHist(const cv::Mat& _i, const cv::Mat* mask, double* h, do
 	cv::minMaxLoc(_tmp, &minVal, &maxVal);
 	_tmp = _tmp / maxVal;
 }
+
+HistMatch::CDF HistMatch::computeCDF(const cv::Mat& _image, const double _range_min, const double _range_max, const int _Nbins) {
+
+	CDF cdf;
+	cdf.Nbins = std::max(_Nbins, 1);
+	cdf.range_min = _range_min;
+	cdf.range_max = (_range_max > _range_min) ? _range_max : _range_min + 1.;
+
+	cv::Mat image_float;
+	_image.convertTo(image_float, CV_32F);
+
+	vector<Mat> chns;
+	cv::split(image_float, chns);
+	cdf.channels.resize(chns.size());
+	for (size_t i = 0; i < chns.size(); i++) {
+		computeChannelCDF(chns[i], cdf.Nbins, cdf.range_min, cdf.range_max, cdf.channels[i]);
+	}
+
+	return cdf;
+}
+
+void HistMatch::computeChannelCDF(const cv::Mat& _channel, const int _Nbins, const double _range_min, const double _range_max, std::vector<double>& _cdf) {
+
+	_cdf.assign(_Nbins, 0.);
+	const double bin_coef = double(_Nbins) / (_range_max - _range_min);
+
+	for (int y = 0; y < _channel.rows; y++) {
+		const float* row = _channel.ptr<float>(y);
+		for (int x = 0; x < _channel.cols; x++) {
+			int bin = (int)((row[x] - _range_min) * bin_coef);
+			bin = std::min(std::max(bin, 0), _Nbins - 1);
+			_cdf[bin] += 1.;
+		}
+	}
+
+	for (int j = 1; j < _Nbins; j++) {
+		_cdf[j] += _cdf[j - 1];
+	}
+	if (_cdf.back() > 0.) {
+		for (int j = 0; j < _Nbins; j++) {
+			_cdf[j] /= _cdf.back();
+		}
+	}
+}
+
+void HistMatch::histMatch(cv::Mat& _image, const CDF& _reference_cdf) {
+
+	const int Nbins = _reference_cdf.Nbins;
+	const double range_min = _reference_cdf.range_min;
+	const double bin_width = (_reference_cdf.range_max - _reference_cdf.range_min) / double(Nbins);
+
+	cv::Mat image_float;
+	if (_image.depth() == CV_32F) {
+		image_float = _image;
+	} else {
+		_image.convertTo(image_float, CV_32F);
+	}
+
+	vector<Mat> chns;
+	cv::split(image_float, chns);
+
+	if (chns.size() != _reference_cdf.channels.size()) {
+		std::cout << "HistMatch::histMatch : image has " << chns.size() << " channels while reference has " << _reference_cdf.channels.size() << std::endl;
+		return;
+	}
+
+	std::vector<double> cdf;
+	/*! Transfer function values at the Nbins+1 bin edges.*/
+	std::vector<float> transfer(Nbins + 1);
+
+	for (size_t i = 0; i < chns.size(); i++) {
+
+		computeChannelCDF(chns[i], Nbins, range_min, _reference_cdf.range_max, cdf);
+		const std::vector<double>& cdf_reference = _reference_cdf.channels[i];
+
+		/*! For each edge of image histogram, value of reference having same CDF, interpolated between reference edges. Both CDF increase : search is linear.*/
+		int k = 0;
+		for (int j = 0; j <= Nbins; j++) {
+
+			const double F = (j == 0) ? 0. : cdf[j - 1];
+			while (k < Nbins && cdf_reference[k] < F) {
+				k++;
+			}
+			const double F_low = (k == 0) ? 0. : cdf_reference[k - 1];
+			const double F_high = cdf_reference[std::min(k, Nbins - 1)];
+			double position = double(k);
+			if (F_high > F_low) {
+				position += std::min(std::max((F - F_low) / (F_high - F_low), 0.), 1.);
+			}
+			transfer[j] = (float)(range_min + position * bin_width);
+		}
+
+		for (int y = 0; y < chns[i].rows; y++) {
+			float* row = chns[i].ptr<float>(y);
+			for (int x = 0; x < chns[i].cols; x++) {
+				double position = (row[x] - range_min) / bin_width;
+				position = std::min(std::max(position, 0.), double(Nbins));
+				const int j = std::min((int)position, Nbins - 1);
+				const float alpha = (float)(position - j);
+				row[x] = transfer[j] + alpha * (transfer[j + 1] - transfer[j]);
+			}
+		}
+	}
+
+	if (_image.depth() == CV_32F) {
+		cv::merge(chns, _image);
+	} else {
+		cv::merge(chns, image_float);
+		image_float.convertTo(_image, _image.type());
+	}
+
+}
\ No newline at end of file
@@ -6,12 +6,32 @@
 #pragma once
 
 #include <opencv2/core.hpp>
+#include <vector>
 #include "Macros.h"
 
 class HistMatch {
 
+public :
+
+	/*! Cumulative distribution functions of each channel of an image, over #Nbins bins regularly covering [#range_min, #range_max].*/
+	struct CDF {
+		int Nbins = 0;
+		double range_min = 0.;
+		double range_max = 1.;
+		/*! For each channel, CDF at upper edge of every bin, normalized to 1.*/
+		std::vector< std::vector<double> > channels;
+	};
+
 private :
 	static void do1ChnHist(const cv::Mat& _i, const cv::Mat* mask, double* h, double* cdf);
+	/*! CDF of a single channel floating point image. Values out of range fall in border bins.*/
+	static void computeChannelCDF(const cv::Mat& _channel, const int _Nbins, const double _range_min, const double _range_max, std::vector<double>& _cdf);
 public :
 	static void histMatchRGB(cv::Mat& src, const cv::Mat* src_mask, const cv::Mat& dst, const cv::Mat* dst_mask);
+
+	/*! CDF of every channel of \p _image (any depth, values in image units). Computed once for a reference, it can be shared by concurrent histMatch calls.*/
+	static CDF computeCDF(const cv::Mat& _image, const double _range_min, const double _range_max, const int _Nbins = 1024);
+	/*! Matches histogram of each channel of \p _image to \p _reference_cdf. Values are mapped with a piecewise linear transfer function between bin edges :
+	floating point images keep their precision (no 8 bits quantization). Other depths are processed in floating point and rounded back.*/
+	static void histMatch(cv::Mat& _image, const CDF& _reference_cdf);
 };
@@ -5,9 +5,11 @@
 
 #pragma once
 
+#include <functional>
 #include "Images4D_base.h"
 #include "ocv_convert.h"
 #include "ocv_rw.h"
+#include "LightFieldContainer.h"
 
 /*! Class to be inherited by 4D light field strucutures. SubaperturesData, EpiLF or LightField*/
 template <class Timg>
@@ -44,8 +46,15 @@ public :
 
 	/*! Asks child class if transpositions are needed for full image design.*/
 	virtual std::pair<bool, bool> get_full_image_transposes() const = 0;
-	/*! Builds a single image containing of views.*/
+	/*! Size of the single image containing views, with \p _spacing pixels between views.*/
+	cv::Size get_full_image_size(bool _l_original_coordinates = true, const unsigned int _spacing = 2) const;
+	/*! Builds a single image containing of views. Views are copied in parallel.*/
 	void build_full_image(Timg& _image, bool _l_original_coordinates = true, const unsigned int _spacing = 2, const typename Timg::value_type _space_value = Timg::value_type::all(ocv::MaxRange<Tvalue>::get())) const;
+	/*! Fills \p _rows with rows of full image starting at row \p _row_start. \p _rows must be allocated with full image width.*/
+	void build_full_image_rows(Timg& _rows, const int _row_start, bool _l_original_coordinates = true, const unsigned int _spacing = 2, const typename Timg::value_type _space_value = Timg::value_type::all(ocv::MaxRange<Tvalue>::get())) const;
+	/*! Writes full image as a binary 8 bits PGM/PPM file, built and written \p _Nrows_band rows at a time : full image is never held in memory.
+	Values are converted from \p _range_input, or if (0, 0) from range of whole light field (ocv::get_minmax_range of every view) : every band is scaled the same.*/
+	bool write_full_image(const std::string& _file_path, const unsigned int _Nrows_band = 64, const ocv::Range<Tvalue> _range_input = ocv::Range<Tvalue>((Tvalue)0, (Tvalue)0), bool _l_original_coordinates = true, const unsigned int _spacing = 2, const typename Timg::value_type _space_value = Timg::value_type::all(ocv::MaxRange<Tvalue>::get())) const;
 	void display_full_image(const unsigned int _spacing = 2, const typename Timg::value_type _space_value = Timg::value_type::all(ocv::MaxRange<Tvalue>::get()), bool _l_original_coordinates = true) const;
 
 
@@ -66,8 +75,14 @@ public :
 	void imwrite(const std::string _prefix, const Tvalue _range_min, const Tvalue _range_max, const OuterModulo& _modulo) const;
 	void imwrite(const std::string _prefix, const ocv::Range<Tvalue>& _range_input, const OuterModulo& _modulo) const;
 	void imwrite(const std::string _prefix, const std::string& _file_extension, const ocv::Range<Tvalue>& _range_input, bool _l_original_coordinates, bool _l_colormap, cv::ColormapTypes _colormap_type = cv::COLORMAP_JET) const;
-	/*! Final method. Write subapertures with segmentation image to display contour (such as a mask for instance)*/
-	void imwrite(const std::string _prefix, bool _l_original_coordinates, const cv::Mat _segmentation_image=cv::Mat(), const ocv::Range<Tvalue> _range_input = ocv::Range<Tvalue>((Tvalue)0, (Tvalue)0), const std::string _file_extension = ocv::write_extension, bool _l_colormap = false, cv::ColormapTypes _colormap_type = cv::COLORMAP_JET, const OuterModulo _modulo = OuterModulo(1, 1)) const;
+	/*! Writes images in a single LightFieldContainer file. Also used by imwrite when file extension is the container one.*/
+	virtual bool write_container(const std::string& _file_path) const;
+	/*! Writes only views for which \p _l_write_view returns true, and calls \p _view_written once a view is written. Both receive writing coordinates of view,
+	\p _l_write_view also receives path of view file relative to data path.
+	Convenient to resume an interrupted writing.*/
+	void imwrite(const std::string _prefix, const Tvalue _range_min, const Tvalue _range_max, const std::function<bool(const UIpair&, const std::string&)>& _l_write_view, const std::function<void(const UIpair&)>& _view_written) const;
+	/*! Final method. Write subapertures with segmentation image to display contour (such as a mask for instance). Views are filtered by \p _l_write_view if set.*/
+	void imwrite(const std::string _prefix, bool _l_original_coordinates, const cv::Mat _segmentation_image=cv::Mat(), const ocv::Range<Tvalue> _range_input = ocv::Range<Tvalue>((Tvalue)0, (Tvalue)0), const std::string _file_extension = ocv::write_extension, bool _l_colormap = false, cv::ColormapTypes _colormap_type = cv::COLORMAP_JET, const OuterModulo _modulo = OuterModulo(1, 1), const std::function<bool(const UIpair&, const std::string&)>& _l_write_view = nullptr, const std::function<void(const UIpair&)>& _view_written = nullptr) const;
 
 
 };
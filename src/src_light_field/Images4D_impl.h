@@ -5,6 +5,7 @@
 
 #pragma once
 
+#include <fstream>
 #include "ocv_rw.h"
 
 template <class Timg>
@@ -72,6 +73,30 @@ bool Images4D<Timg>::has_same_dimensions(const Images4D<Timg_arg>& _images) cons
 	return get_outer_size() == _images.get_outer_size() && get_inner_size() == _images.get_inner_size();
 }
 
+template <class Timg>
+cv::Size Images4D<Timg>::get_full_image_size(bool _l_original_coordinates, const unsigned int _spacing) const {
+
+	if (this->empty()) {
+		return cv::Size(0, 0);
+	}
+
+	std::pair<bool, bool> l_transposes = get_full_image_transposes();
+
+	cv::Size inner_size = get_inner_size();
+	if (l_transposes.first != l_transposes.second) {
+		std::swap(inner_size.width, inner_size.height);
+	}
+	cv::Size outer_size_original = get_outer_size_original(_l_original_coordinates);
+
+	cv::Size size = inner_size;
+	size.width *= outer_size_original.height;
+	size.width += _spacing * (outer_size_original.height - 1);
+	size.height *= outer_size_original.width;
+	size.height += _spacing * (outer_size_original.width - 1);
+
+	return size;
+}
+
 template <class Timg>
 void Images4D<Timg>::build_full_image(Timg& _image, bool _l_original_coordinates, const unsigned int _spacing, const typename Timg::value_type _space_value) const {
 
@@ -80,67 +105,148 @@ void Images4D<Timg>::build_full_image(Timg& _image, bool _l_original_coordinates
 
 	if (!this->empty()) {
 
-		std::pair<bool, bool> l_transposes = get_full_image_transposes();
+		_image.create(get_full_image_size(_l_original_coordinates, _spacing));
+		build_full_image_rows(_image, 0, _l_original_coordinates, _spacing, _space_value);
 
-		cv::Size inner_size = get_inner_size();
-		if (l_transposes.first != l_transposes.second) {
-			std::swap(inner_size.width, inner_size.height);
-		}
-		cv::Size outer_size = get_outer_size();
-		if (l_transposes.second) {
-			std::swap(outer_size.width, outer_size.height);
-		}
+	} else {
+
+		_image.create(cv::Size(0, 0));
+
+	}
+
+}
 
-		//////////////
+template <class Timg>
+void Images4D<Timg>::build_full_image_rows(Timg& _rows, const int _row_start, bool _l_original_coordinates, const unsigned int _spacing, const typename Timg::value_type _space_value) const {
 
-		Images4D_base::Tarray<UIpair> coordinates;
-		coordinates = get_coordinates_from_original(_l_original_coordinates);
-		cv::Size outer_size_original = get_outer_size_original(_l_original_coordinates);
+	std::pair<bool, bool> l_transposes = get_full_image_transposes();
+	const bool l_transpose = l_transposes.first != l_transposes.second;
 
-		cv::Size size = inner_size;
-		size.width *= outer_size_original.height;
-		size.width += _spacing * (outer_size_original.height - 1);
-		size.height *= outer_size_original.width;
-		size.height += _spacing * (outer_size_original.width - 1);
-		_image.create(size);
-		_image = _space_value;
+	cv::Size inner_size = get_inner_size();
+	if (l_transpose) {
+		std::swap(inner_size.width, inner_size.height);
+	}
 
-		Timg image;
-		Timg image_transposed;
+	Images4D_base::Tarray<UIpair> coordinates;
+	coordinates = get_coordinates_from_original(_l_original_coordinates);
+	cv::Size outer_size_original = get_outer_size_original(_l_original_coordinates);
 
-		unsigned int i1, j1;
-		for (unsigned int i_ori = 0; i_ori < (unsigned int)outer_size_original.width; i_ori++) {
-			for (unsigned int j_ori = 0; j_ori < (unsigned int)outer_size_original.height; j_ori++) {
-				i1 = i_ori;
-				j1 = j_ori;
+	/*! Only spacing and empty views keep the space value : no need to fill otherwise.*/
+	if (_spacing > 0 || is_sparse()) {
+		_rows = _space_value;
+	}
 
-				unsigned int rect_x = j1 * (inner_size.width + _spacing);
-				unsigned int rect_y = i1 * (inner_size.height + _spacing);
+	const int row_end = _row_start + _rows.rows;
+	const unsigned int Ntiles = outer_size_original.width * outer_size_original.height;
 
-				if (l_transposes.second) {
-					std::swap(i1, j1);
-				}
+	/*! Tiles are independent : each view is copied, or transposed, straight into its rows of destination.*/
+	cv::parallel_for_(cv::Range(0, int(Ntiles)), [&](const cv::Range& _range) {
+
+		for (int t = _range.start; t < _range.end; t++) {
+
+			const unsigned int i_ori = t / outer_size_original.height;
+			const unsigned int j_ori = t % outer_size_original.height;
+
+			const int rect_x = j_ori * (inner_size.width + _spacing);
+			const int rect_y = i_ori * (inner_size.height + _spacing);
+
+			/*! Rows of tile within destination rows.*/
+			const int y_begin = std::max(rect_y, _row_start);
+			const int y_end = std::min(rect_y + inner_size.height, row_end);
 
-				image = (*this)(coordinates[i_ori][j_ori].first, coordinates[i_ori][j_ori].second);
+			const Timg& image = (*this)(coordinates[i_ori][j_ori].first, coordinates[i_ori][j_ori].second);
 
-				if (l_transposes.first != l_transposes.second) {
-					cv::transpose(image, image_transposed);
-					image_transposed.copyTo(_image(cv::Rect(rect_x, rect_y, inner_size.width, inner_size.height)));
+			if (y_begin < y_end && ocv::is_valid(image)) {
+
+				Timg tile = _rows(cv::Rect(rect_x, y_begin - _row_start, inner_size.width, y_end - y_begin));
+
+				if (l_transpose) {
+					/*! Rows of transposed image are columns of image.*/
+					cv::transpose(image.colRange(y_begin - rect_y, y_end - rect_y), tile);
 				} else {
-					image.copyTo(_image(cv::Rect(rect_x, rect_y, inner_size.width, inner_size.height)));
+					image.rowRange(y_begin - rect_y, y_end - rect_y).copyTo(tile);
 				}
 			}
 		}
+	});
 
-	} else {
+}
 
-		_image.create(cv::Size(0, 0));
+template <class Timg>
+bool Images4D<Timg>::write_full_image(const std::string& _file_path, const unsigned int _Nrows_band, const ocv::Range<Tvalue> _range_input, bool _l_original_coordinates, const unsigned int _spacing, const typename Timg::value_type _space_value) const {
+
+	const int Nchannels = Tvec::channels;
 
+	if (Nchannels != 1 && Nchannels != 3) {
+		std::cout << "Images4D::write_full_image : only 1 or 3 channels images can be streamed" << std::endl;
+		return false;
 	}
 
-}
+	if (this->empty() || _Nrows_band == 0) {
+		std::cout << "Images4D::write_full_image : nothing to write" << std::endl;
+		return false;
+	}
 
+	std::ofstream file(_file_path, std::ios::binary);
 
+	if (!file.is_open()) {
+		std::cout << "WARNING : Failed to write full image " << _file_path << std::endl;
+		return false;
+	}
+
+	const cv::Size size = get_full_image_size(_l_original_coordinates, _spacing);
+
+	/*! Binary PGM or PPM header.*/
+	file << (Nchannels == 1 ? "P5" : "P6") << "\n" << size.width << " " << size.height << "\n255\n";
+
+	/*! Automatic range is the one of whole light field, so that every band is scaled the same.*/
+	ocv::Range<Tvalue> range_input = _range_input;
+	if (range_input == ocv::Range<Tvalue>((Tvalue)0, (Tvalue)0)) {
+		range_input.first = std::numeric_limits<Tvalue>::max();
+		range_input.second = std::numeric_limits<Tvalue>::lowest();
+		const cv::Size outer_size = get_outer_size();
+		for (unsigned int i = 0; i < (unsigned int)outer_size.width; i++) {
+			for (unsigned int j = 0; j < (unsigned int)outer_size.height; j++) {
+				const Timg& image = (*this)(i, j);
+				if (ocv::is_valid(image)) {
+					const ocv::Range<Tvalue> range_image = ocv::get_minmax_range(image);
+					range_input.first = std::min(range_input.first, range_image.first);
+					range_input.second = std::max(range_input.second, range_image.second);
+				}
+			}
+		}
+		if (range_input.first > range_input.second) {
+			range_input = ocv::get_minmax_range(Timg());
+		}
+	}
+
+	Timg band;
+	cv::Mat_< cv::Vec<uchar, Tvec::channels> > band_write;
+
+	for (int row_start = 0; row_start < size.height; row_start += _Nrows_band) {
+
+		band.create(std::min((int)_Nrows_band, size.height - row_start), size.width);
+		build_full_image_rows(band, row_start, _l_original_coordinates, _spacing, _space_value);
+
+		ocv::convertTo(band, band_write, range_input);
+
+		/*! PPM stores RGB.*/
+		if (Nchannels == 3) {
+			cv::cvtColor(band_write, band_write, cv::COLOR_BGR2RGB);
+		}
+
+		for (int y = 0; y < band_write.rows; y++) {
+			file.write((const char*)band_write.ptr(y), band_write.cols * Nchannels);
+		}
+	}
+
+	if (!file.good()) {
+		std::cout << "WARNING : Failed to write full image " << _file_path << std::endl;
+		return false;
+	}
+
+	return true;
+}
 
 template <class Timg>
 void Images4D<Timg>::display_full_image(const unsigned int _spacing, const typename Timg::value_type _space_value, bool _l_original_coordinates) const {
@@ -261,7 +367,30 @@ void Images4D<Timg>::imwrite(const std::string _prefix, const std::string& _file
 }
 
 template <class Timg>
-void Images4D<Timg>::imwrite(const std::string _prefix, bool _l_original_coordinates, const cv::Mat _segmentation_image, const ocv::Range<Tvalue> _range_input, const std::string _file_extension, bool _l_colormap, cv::ColormapTypes _colormap_type, const OuterModulo _modulo) const {
+bool Images4D<Timg>::write_container(const std::string& _file_path) const {
+
+	std::cout << "No light field container writing for " << get_class_name() << std::endl;
+	return false;
+}
+
+template <class Timg>
+void Images4D<Timg>::imwrite(const std::string _prefix, const Tvalue _range_min, const Tvalue _range_max, const std::function<bool(const UIpair&, const std::string&)>& _l_write_view, const std::function<void(const UIpair&)>& _view_written) const {
+
+	imwrite(_prefix, true, cv::Mat(), ocv::Range<Tvalue>(_range_min, _range_max), ocv::write_extension, false, cv::COLORMAP_JET, OuterModulo(1, 1), _l_write_view, _view_written);
+}
+
+template <class Timg>
+void Images4D<Timg>::imwrite(const std::string _prefix, bool _l_original_coordinates, const cv::Mat _segmentation_image, const ocv::Range<Tvalue> _range_input, const std::string _file_extension, bool _l_colormap, cv::ColormapTypes _colormap_type, const OuterModulo _modulo, const std::function<bool(const UIpair&, const std::string&)>& _l_write_view, const std::function<void(const UIpair&)>& _view_written) const {
+
+	/*! Single file containing raw values of every image : range, colormap and modulo don't apply.*/
+	if (_file_extension == LightFieldContainer::file_extension()) {
+		std::string prefix = _prefix;
+		if (!prefix.empty() && prefix.back() != '/' && prefix.back() != '\\') {
+			prefix += "-";
+		}
+		write_container(Misc::to_data_path(prefix + get_name() + _file_extension));
+		return;
+	}
 
 	Timg image;
 	Timg image_segmented;
@@ -307,12 +436,15 @@ void Images4D<Timg>::imwrite(const std::string _prefix, bool _l_original_coordin
 					image = (*this)(i, j);
 				}
 
-				if (ocv::is_valid(image)) {
+				if (ocv::is_valid(image) && (!_l_write_view || _l_write_view(writing_coordinates, full_name + _file_extension))) {
 
 							image_segmented = image;
 
 						ocv::imwrite(full_name, image_segmented, _range_input, _file_extension);
 
+					if (_view_written) {
+						_view_written(writing_coordinates);
+					}
 
 				}
 
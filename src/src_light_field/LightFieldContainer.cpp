@@ -0,0 +1,149 @@
+/******************************************************************/
+/***            Pierre Allain, INRIA, February 2020				  */
+/***        GNU Affero General Public License version 3			  */
+/******************************************************************/
+
+#include "LightFieldContainer.h"
+#include "misc_funcs.h"
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+const std::string& LightFieldContainer::file_extension() {
+	static const std::string _file_extension_ = ".lfc";
+	return _file_extension_;
+}
+
+LightFieldContainer::Header LightFieldContainer::get_header() {
+
+	Header header;
+	std::memset(&header, 0, sizeof(Header));
+	std::memcpy(header.magic, "FLFC", 4);
+	header.version = version;
+	header.data_offset = ((sizeof(Header) + data_alignment - 1) / data_alignment) * data_alignment;
+	return header;
+}
+
+size_t LightFieldContainer::get_view_step(const Header& _header) {
+
+	return size_t(_header.view_rows) * _header.width * CV_ELEM_SIZE(_header.type);
+}
+
+bool LightFieldContainer::check_header(const Header& _header, const size_t _file_size) {
+
+	/*! Same limit as SubapertureBundle : more views denotes a corrupted file.*/
+	const uint64_t Nviews_max = 10000;
+	const uint64_t int_max = (uint64_t)std::numeric_limits<int>::max();
+
+	if (_header.type != CV_MAT_TYPE(_header.type) || CV_MAT_DEPTH(_header.type) > CV_64F || CV_MAT_CN(_header.type) != 3) {
+		return false;
+	}
+
+	if (_header.Nu == 0 || _header.Nv == 0 || _header.width == 0 || _header.height == 0 || _header.view_rows < _header.height) {
+		return false;
+	}
+
+	const uint64_t Nviews = uint64_t(_header.Nu) * _header.Nv;
+	if (Nviews > Nviews_max || _header.width > int_max || _header.view_rows > int_max / Nviews) {
+		return false;
+	}
+
+	if (_header.data_offset < sizeof(Header) || _header.data_offset % data_alignment != 0 || _header.data_offset > _file_size) {
+		return false;
+	}
+
+	/*! Views fit in file, compared by division to prevent overflows : row size is below int max times element size.*/
+	const uint64_t row_size = uint64_t(_header.width) * CV_ELEM_SIZE(_header.type);
+	if (_header.view_rows > (_file_size - _header.data_offset) / Nviews / row_size) {
+		return false;
+	}
+
+	return true;
+}
+
+bool LightFieldContainer::is_container(const std::string& _file_path) {
+
+	return Misc::get_file_extension(_file_path) == file_extension();
+}
+
+bool LightFieldContainer::write(const std::string& _file_path, const Header& _header, const std::vector<cv::Mat>& _views) {
+
+	if (_views.size() != size_t(_header.Nu) * _header.Nv) {
+		std::cout << "LightFieldContainer : number of views doesn't match header" << std::endl;
+		return false;
+	}
+
+	std::ofstream file(_file_path, std::ios::binary);
+
+	if (file.is_open()) {
+
+		file.write(reinterpret_cast<const char*>(&_header), sizeof(Header));
+		std::vector<char> padding(_header.data_offset - sizeof(Header), 0);
+		file.write(padding.data(), padding.size());
+
+		const size_t row_size = size_t(_header.width) * CV_ELEM_SIZE(_header.type);
+		padding.assign(row_size, 0);
+
+		for (const cv::Mat& view : _views) {
+
+			if (view.type() != _header.type || view.cols != int(_header.width) || view.rows != int(_header.height)) {
+				std::cout << "LightFieldContainer : view doesn't match header" << std::endl;
+				return false;
+			}
+			/*! Views can be regions of interest : written row by row.*/
+			for (int y = 0; y < view.rows; y++) {
+				file.write(reinterpret_cast<const char*>(view.ptr(y)), row_size);
+			}
+			for (unsigned int y = _header.height; y < _header.view_rows; y++) {
+				file.write(padding.data(), row_size);
+			}
+		}
+
+		return bool(file);
+
+	} else {
+		std::cout << "WARNING : Failed to write light field container " << _file_path << std::endl;
+		return false;
+	}
+
+}
+
+std::shared_ptr<void> LightFieldContainer::map(const std::string& _file_path, Header& _header, uchar*& _data) {
+
+	namespace bip = boost::interprocess;
+
+	std::shared_ptr<bip::mapped_region> region;
+
+	try {
+		bip::file_mapping file(_file_path.c_str(), bip::read_only);
+		region = std::make_shared<bip::mapped_region>(file, bip::copy_on_write);
+	} catch (const bip::interprocess_exception& _exception) {
+		std::cout << "Can't map light field container " << _file_path << " : " << _exception.what() << std::endl;
+		return nullptr;
+	}
+
+	if (region->get_size() < sizeof(Header)) {
+		std::cout << "Invalid light field container " << _file_path << std::endl;
+		return nullptr;
+	}
+
+	std::memcpy(&_header, region->get_address(), sizeof(Header));
+
+	if (std::memcmp(_header.magic, "FLFC", 4) != 0 || _header.version != version) {
+		std::cout << "Invalid light field container " << _file_path << " (magic or version)" << std::endl;
+		return nullptr;
+	}
+
+	_header.name[sizeof(_header.name) - 1] = '\0';
+
+	if (!check_header(_header, region->get_size())) {
+		std::cout << "WARNING : Invalid light field container " << _file_path << " (header doesn't match file)" << std::endl;
+		return nullptr;
+	}
+
+	_data = static_cast<uchar*>(region->get_address()) + _header.data_offset;
+
+	return region;
+}
@@ -0,0 +1,65 @@
+/******************************************************************/
+/***            Pierre Allain, INRIA, February 2020				  */
+/***        GNU Affero General Public License version 3			  */
+/******************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include <opencv2/core.hpp>
+
+/*! Native binary file format of a light field (.lfc), made to be memory mapped.
+Layout : #Header, padded to #data_alignment bytes, then the raw planes of every view in (u, v) order.
+Each view is stored on Header::view_rows rows (image rows followed by zero padding rows), so that every view starts on a 64 bytes boundary.
+That is the layout of SubaperturesData contiguous storage : mapped views are exposed without copy. Values are stored in native byte order.*/
+class LightFieldContainer {
+
+public :
+
+	struct Header {
+		/*! "FLFC".*/
+		char magic[4];
+		uint32_t version;
+		uint32_t Nu;
+		uint32_t Nv;
+		uint32_t width;
+		uint32_t height;
+		/*! OpenCV type of views (ex : CV_32FC3).*/
+		int32_t type;
+		/*! Number of rows of a view in file, including padding.*/
+		uint32_t view_rows;
+		uint32_t l_invert_uv;
+		uint32_t reserved;
+		double baseline[2];
+		double center_coordinates[2];
+		/*! Offset in bytes of first view.*/
+		uint64_t data_offset;
+		/*! Light field name, null terminated.*/
+		char name[128];
+	};
+
+	static const std::string& file_extension();
+	static const uint32_t version = 1;
+	/*! Alignment of the first view in file : a memory page.*/
+	static const size_t data_alignment = 4096;
+
+	/*! Returns a header with magic, version and data offset set.*/
+	static Header get_header();
+	/*! Number of bytes between two consecutive views.*/
+	static size_t get_view_step(const Header& _header);
+	/*! Whether \p _header describes a light field lying in a file of \p _file_size bytes : valid 3 channels type, non empty views,
+	aligned data offset, and views (within OpenCV sizes) ending before end of file.*/
+	static bool check_header(const Header& _header, const size_t _file_size);
+	/*! Whether \p _file_path has the container file extension.*/
+	static bool is_container(const std::string& _file_path);
+
+	/*! Writes \p _views (Nu*Nv images in (u, v) order, of size and type given by \p _header) in \p _file_path.*/
+	static bool write(const std::string& _file_path, const Header& _header, const std::vector<cv::Mat>& _views);
+	/*! Maps \p _file_path in memory (copy on write : modifying views doesn't modify file). Fills \p _header and \p _data (first view).
+	Returns the mapping, which must be kept alive as long as views are used. Null if failed.*/
+	static std::shared_ptr<void> map(const std::string& _file_path, Header& _header, uchar*& _data);
+
+};
@@ -5,6 +5,10 @@
 
 #include "SubapertureBundle.h"
 #include "misc_funcs.h"
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <functional>
 
 unsigned int& SubapertureBundle::Nimages_auto() {
 	static unsigned int Nimages_auto = 256;
@@ -552,6 +556,133 @@ float SubapertureBundle::get_likeliness() const {
 	return likeliness;
 }
 
+std::string SubapertureBundle::get_manifest_path(const std::string& _directory_path) {
+
+	std::string directory_path = _directory_path;
+	while (directory_path.size() > 1 && (directory_path.back() == '/' || directory_path.back() == '\\')) {
+		directory_path.pop_back();
+	}
+
+	/*! Manifests lie in data path, never in light field dataset : name of directory, and hash of its path to separate directories with same name.*/
+	std::ostringstream file_name;
+	file_name << Misc::extract_name_from_path(directory_path) << "_" << std::hex << std::hash<std::string>()(directory_path) << ".manifest";
+	return Misc::to_data_path(Misc::concat_path_and_filename("manifests", file_name.str()));
+}
+
+std::string SubapertureBundle::get_directory_state(const std::string& _directory_path, bool _l_recursive) {
+
+	std::ostringstream state;
+	state << Misc::get_last_write_time(_directory_path) << " " << Misc::count_directory_entries(_directory_path);
+
+	if (_l_recursive) {
+		/*! Modification time of a directory doesn't change with its sub-directories content, so every recursed directory is described.*/
+		std::vector<std::string> directory_names = Misc::get_file_names(_directory_path, Misc::FileType::directory);
+		std::sort(directory_names.begin(), directory_names.end());
+		for (const std::string& directory_name : directory_names) {
+			state << " [" << directory_name << " " << get_directory_state(Misc::concat_path_and_filename(_directory_path, directory_name), _l_recursive) << "]";
+		}
+	}
+
+	return state.str();
+}
+
+bool SubapertureBundle::write_manifest(const std::string& _directory_path, const std::string& _key, bool _l_recursive) const {
+
+	Misc::create_directory("manifests");
+	std::ofstream file(get_manifest_path(_directory_path));
+
+	if (file.is_open()) {
+
+		file << "SubapertureBundle 2" << std::endl;
+		file << _key << std::endl;
+		file << _directory_path << std::endl;
+		file << get_directory_state(_directory_path, _l_recursive) << std::endl;
+
+		file << parameters.l_single_index_for_subapertures << " " << parameters.UVdims.first << " " << parameters.UVdims.second << " " << parameters.l_begin0 << " " << parameters.uvt_position_in_name.size();
+		for (unsigned int position : parameters.uvt_position_in_name) {
+			file << " " << position;
+		}
+		file << std::endl;
+
+		file << l_time << " " << time_position << " " << Nuv_images << " " << uv_min.first << " " << uv_min.second << " " << uv_max.first << " " << uv_max.second << " " << Nu << " " << Nv << std::endl;
+		file << time_index << " " << time_index_min << " " << time_index_max << " " << time_indices_var << std::endl;
+
+		/*! One image per line : paths may contain spaces.*/
+		file << uv_images_mapping.size() << std::endl;
+		for (Tmapping::const_iterator iterator = uv_images_mapping.begin(); iterator != uv_images_mapping.end(); ++iterator) {
+			file << iterator->first.first << " " << iterator->first.second << " " << iterator->second << std::endl;
+		}
+
+		return true;
+
+	} else {
+		std::cout << "WARNING : Failed to write subapertures manifest " << get_manifest_path(_directory_path) << std::endl;
+		return false;
+	}
+
+}
+
+bool SubapertureBundle::read_manifest(const std::string& _directory_path, const std::string& _key, bool _l_recursive) {
+
+	std::ifstream file(get_manifest_path(_directory_path));
+
+	if (!file.is_open()) {
+		return false;
+	}
+
+	std::string line;
+	std::getline(file, line);
+	if (line != "SubapertureBundle 2") {
+		return false;
+	}
+
+	std::getline(file, line);
+	if (line != _key) {
+		return false;
+	}
+
+	/*! Hash of path names the manifest : a collision is detected by stored path.*/
+	std::getline(file, line);
+	if (line != _directory_path) {
+		return false;
+	}
+
+	std::getline(file, line);
+	if (!file || line != get_directory_state(_directory_path, _l_recursive)) {
+		return false;
+	}
+
+	Parameters parameters_read;
+	size_t Npositions;
+	file >> parameters_read.l_single_index_for_subapertures >> parameters_read.UVdims.first >> parameters_read.UVdims.second >> parameters_read.l_begin0 >> Npositions;
+	parameters_read.uvt_position_in_name.resize(Npositions);
+	for (unsigned int& position : parameters_read.uvt_position_in_name) {
+		file >> position;
+	}
+
+	SubapertureBundle bundle(parameters_read);
+	file >> bundle.l_time >> bundle.time_position >> bundle.Nuv_images >> bundle.uv_min.first >> bundle.uv_min.second >> bundle.uv_max.first >> bundle.uv_max.second >> bundle.Nu >> bundle.Nv;
+	file >> bundle.time_index >> bundle.time_index_min >> bundle.time_index_max >> bundle.time_indices_var;
+
+	size_t Nimages;
+	file >> Nimages;
+	UVindices uv;
+	for (size_t i = 0; i < Nimages && file; i++) {
+		file >> uv.first >> uv.second;
+		/*! Skip separator, then remaining of line is path.*/
+		file.get();
+		std::getline(file, line);
+		bundle.uv_images_mapping[uv] = line;
+	}
+
+	if (!file || bundle.uv_images_mapping.size() != Nimages) {
+		return false;
+	}
+
+	*this = bundle;
+	return true;
+}
+
 SubapertureBundle::operator bool() const {
 
 	bool l_ok = true;
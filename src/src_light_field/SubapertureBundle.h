@@ -148,6 +148,17 @@ public :
 	/*! Compares bundles using get_likeliness.*/
 	bool operator<(const SubapertureBundle& _subapertures) const;
 
+	/*! Path of manifest caching bundle of light field directory \p _directory_path. Manifest lies in "manifests" directory of data path, not in light field dataset.*/
+	static std::string get_manifest_path(const std::string& _directory_path);
+	/*! Modification time and number of entries of directory \p _directory_path, and of all its sub-directories if \p _l_recursive.*/
+	static std::string get_directory_state(const std::string& _directory_path, bool _l_recursive);
+	/*! Writes bundle in manifest of \p _directory_path, with state of directory (get_directory_state).
+	\p _key describes reading parameters which led to this bundle.*/
+	bool write_manifest(const std::string& _directory_path, const std::string& _key, bool _l_recursive) const;
+	/*! Reads bundle from manifest of \p _directory_path. Fails if manifest doesn't exist or is outdated :
+	different \p _key, or state of directory (get_directory_state) changed.*/
+	bool read_manifest(const std::string& _directory_path, const std::string& _key, bool _l_recursive);
+
 	/*! Checks wether bundle contains a reasonable number of images. Usefull to prevent further allocation of huge number of images in case of DirectoryParser returns a wrong value.*/
 	operator bool() const;
 
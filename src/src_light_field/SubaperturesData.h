@@ -10,6 +10,12 @@
 #include "SubaperturesLoader.h"
 #include "Images4D.h"
 #include "SubaperturesDataBase.h"
+#include <memory>
+
+namespace SubaperturesExpression {
+	template <class Texpr>
+	struct Expression;
+}
 
 /*! Class representing a light field as a set of subaperture images. Most common way of using a light field.*/
 template <class Timg=ocv::Timg>
@@ -36,8 +42,16 @@ public:
 
 private:
 
-	/*! Contains images of light field.*/
+	/*! Contains images of light field. Accessed through #angular_remap, so views order may differ from angular indices.*/
 	TsubAp subaperture_images;
+	/*! Maps angular indices onto #subaperture_images. Angular flips, transposes, crops and views removal only update it.*/
+	AngularRemap angular_remap;
+	/*! Optional single allocation holding every view (contiguous backend). Views are then headers on it. Empty if views are allocated independently.*/
+	cv::Mat storage;
+	/*! Number of rows of a view in #storage, including padding rows keeping views aligned.*/
+	unsigned int storage_view_rows = 0;
+	/*! Memory mapped LightFieldContainer file on which #storage lies, if loaded from one. Must outlive views.*/
+	std::shared_ptr<void> file_mapping;
 
 public:
 
@@ -58,6 +72,9 @@ public:
 	void copyTo(SubaperturesData<Timg_arg>& _subapertures) const;
 	template <class Timg_arg>
 	void copyPropertiesTo(SubaperturesData<Timg_arg>& _subapertures) const;
+	/*! Converts only views \p _indices in \p _subapertures (natural range of types), other views are left empty. Properties are copied.*/
+	template <class Timg_arg>
+	void convertTo(SubaperturesData<Timg_arg>& _subapertures, const std::vector<UVindices>& _indices) const;
 
 	unsigned int get_Nu() const;
 	unsigned int get_Nv() const;
@@ -69,6 +86,21 @@ public:
 
 	void resize(const unsigned int _Nu, const unsigned int _Nv, const cv::Size& _image_size);
 	void resize(const unsigned int _Nu, const unsigned int _Nv);
+	/*! Allocates every view in a single aligned block with (u, v, y, x, c) strides. Views are zero-copy headers on this block. Values are not initialized.*/
+	void resize_contiguous(const unsigned int _Nu, const unsigned int _Nv, const cv::Size& _image_size);
+	/*! Moves views in a single aligned block, see #resize_contiguous. Light field must be coherent and not sparse.*/
+	bool make_contiguous();
+	/*! Whether every view lies in the single block. Assigning a view with another image breaks it, while writing in a view doesn't.*/
+	bool is_contiguous() const;
+	/*! Gives views their own memory once cropped : views become continuous, and cropped pixels and views are released.
+	Light field keeps a single block if it had one (see #make_contiguous), otherwise each cropped view is copied.*/
+	void compact();
+	/*! Single block of views. Empty if views are allocated independently.*/
+	const cv::Mat& get_storage() const;
+	/*! Number of bytes between two consecutive views (v stride). u stride is Nv times this value.*/
+	size_t get_view_step() const;
+	/*! Alignment in bytes of every view of contiguous storage.*/
+	static const size_t storage_alignment = 64;
 	void resize(const UVindices& _Nuv, const cv::Size& _image_size);
 	void resize(const cv::Size& _subapertures_size, const cv::Size& _image_size);
 	void resize_images(const cv::Size& _image_size);
@@ -98,6 +130,10 @@ public:
 	template <class Timg_input>
 	SubaperturesData<Timg>& operator=(const SubaperturesData<Timg_input>& _subapertures);
 
+	/*! Evaluates a lazy expression of light fields and scalars, such as (a * w + b) / w_sum, in a single pass per pixel and in parallel across views (see SubaperturesExpression.h).*/
+	template <class Texpr>
+	SubaperturesData<Timg>& operator=(const SubaperturesExpression::Expression<Texpr>& _expression);
+
 	SubaperturesData<Timg>& copyFrom(const Timg& _image);
 	SubaperturesData<Timg>& operator+=(const SubaperturesData<Timg>& _subapertures);
 	SubaperturesData<Timg>& operator-=(const SubaperturesData<Timg>& _subapertures);
@@ -119,7 +155,7 @@ public:
 	SubaperturesData<Timg>& exp();
 
 
-	/*! Add subapertures inbetween existing ones. Argument \p _n_images stands for number of subapertures introduced between each one.*/
+	/*! Add subapertures inbetween existing ones. Argument \p _n_images stands for number of subapertures introduced between each one. Introduced views are null, see ShiftSubapertures::warp_refine for view synthesis.*/
 	void refine(const unsigned int& _n_images);
 	void refine(const Upair& _n_images);
 	void get_refined(SubaperturesData<Timg>& _subapertures, const unsigned int& _n_images) const;
@@ -128,15 +164,24 @@ public:
 	/*! Remove subapertures inbetween existing ones.*/
 	bool get_coarsened(SubaperturesData<Timg>& _subapertures, const Upair& _n_images) const;
 
-	/*! Add/remove subapertures at angular boundaries. With \p _offsets (left, up, right, bottom). Positive=>add, negative=>remove (like angular cropping).*/
+	/*! Add/remove subapertures at angular boundaries. With \p _offsets (left, up, right, bottom). Positive=>add, negative=>remove (like angular cropping).
+	Removing only is done through angular remap, without moving views.*/
 	void angular_resize(const Leupribo<unsigned int>& _offsets);
 	void angular_resize(const Leupribo<int>& _offsets);
 	void get_angular_resized(SubaperturesData<Timg>& _subapertures, const Leupribo<unsigned int>& _offsets) const;
 	void get_angular_resized(SubaperturesData<Timg>& _subapertures, const Leupribo<int>& _offsets) const;
 
-	/*! Flip subapertures angularly along u direction if _orientation is ocv::horizontal, along v direction if _orientation is ocv::vertical.*/
+	/*! Flip subapertures angularly along u direction if _orientation is ocv::horizontal, along v direction if _orientation is ocv::vertical.
+	Views are not moved : only angular remap is updated.*/
 	void flip_angular(const ocv::Orientation& _orientation);
+	/*! Views are not moved : only angular remap is updated.*/
 	void transpose_angular();
+	/*! Removes _Nviews every _Nviews+1 views, without moving views. Same result as get_coarsened().*/
+	bool remove_angular(const Upair& _n_images);
+	/*! Reorders views headers according to angular remap, which becomes identity. Views removed by angular transforms are released. Pixels are not copied.*/
+	void compact_angular();
+	/*! Whether views grid is in natural order. Ie, no pending angular transform.*/
+	bool is_angular_identity() const;
 
 	cv::Size get_image_size() const;
 
@@ -154,8 +199,9 @@ public:
 
 	std::pair<bool, bool> get_full_image_transposes() const;
 
-	/*! Crops subapertures left, up, right, bottom). */
+	/*! Crops subapertures left, up, right, bottom). Views become region of interest headers sharing original buffers (no copy), see #compact. */
 	void crop_spatially(const Leupribo<unsigned int>& _Ncrop_pixels);
+	/*! Views are not moved if at least one view remains : only angular remap is updated.*/
 	void crop_angular(const Leupribo<unsigned int>& _Ncrop_suabpertures);
 	void crop_angular_spatially(const Leupribo<unsigned int>& _Ncrop_angular, const Leupribo<unsigned int>& _Ncrop_spatial);
 
@@ -165,6 +211,7 @@ public:
 	void apply_transforms(const SubaperturesDataBase::DimensionsTransforms& _transforms);
 
 	///// Projection on single image //////
+	/*! Projections are parallel over tiles of rows, with views accumulated in (u, v) order : results don't depend on number of threads.*/
 	/*! To get sum of all subapertures.*/
 	void get_sum_image(Timg& _result) const;
 	/*! To get mean of all subapertures.*/
@@ -197,6 +244,7 @@ public:
 	/*! Rescale images from min max values range to Tvalue range. Convenient if values are out of range of [0, 1] for floating point Tvalue for instance.*/
 	void rescale_min_max();
 
+	/*! Histograms of views are computed in parallel and summed in (u, v) order.*/
 	std::vector<Tvalue> calcHist(cv::Mat& _histogram, const unsigned int _Nvalues = 100, const ocv::Range<Tvalue> _range = { 0,0 }) const;
 	std::vector<Tvalue> calcHist_minmax(cv::Mat& _histogram, const unsigned int _Nvalues = 100) const;
 
@@ -209,6 +257,12 @@ public:
 
 	static SubapertureBundle get_subapertures_bundle(const SubaperturesLoader& _loader);
 
+	/*! Memory maps a LightFieldContainer file. Views are exposed without copy if file type matches Timg (converted otherwise).
+	Modifying views doesn't modify file. Image headers of views must not be used after this object is cleared or destroyed.*/
+	bool load_container(const std::string& _file_path);
+	/*! Writes light field in a LightFieldContainer file (raw values, with baseline and center coordinates).*/
+	bool write_container(const std::string& _file_path) const;
+
 private:
 
 	/*! Modifications on \p _images depending one parameters \p _cfg.*/
@@ -224,3 +278,4 @@ private:
 
 };
 
+#include "SubaperturesExpression.h"
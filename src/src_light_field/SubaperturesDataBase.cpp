@@ -125,6 +125,15 @@ std::pair<UVindices, bool> SubaperturesDataBase::is_valid_angular_modulo(const U
 	return result;
 }
 
+unsigned int SubaperturesDataBase::get_aligned_rows(const unsigned int _Nrows, const size_t _row_size, const size_t _alignment) {
+
+	unsigned int Nrows = _Nrows;
+	while ((Nrows * _row_size) % _alignment != 0) {
+		Nrows++;
+	}
+	return Nrows;
+}
+
 std::pair<UVindices, bool> SubaperturesDataBase::get_Nuv_transforms(const UVindices& _Nuv, const std::array<unsigned int, 4>& _subaperture_offsets, const Upair& _angular_modulo) {
 
 	std::pair<UVindices, bool> result;
@@ -385,4 +394,106 @@ const Fpair& SubaperturesDataBase::DimensionsTransforms::Transform::get_baseline
 
 	return fpair;
 
+}
+
+///////// AngularRemap
+
+void SubaperturesDataBase::AngularRemap::reset(const UVindices& _Nuv) {
+
+	Nuv = _Nuv;
+	origin = Ipair(0, 0);
+	step = Ipair(1, 1);
+	l_transposed = false;
+
+}
+
+const UVindices& SubaperturesDataBase::AngularRemap::get_Nuv() const {
+
+	return Nuv;
+
+}
+
+bool SubaperturesDataBase::AngularRemap::is_identity(const UVindices& _Nuv_grid) const {
+
+	return Nuv == _Nuv_grid && origin == Ipair(0, 0) && step == Ipair(1, 1) && !l_transposed;
+
+}
+
+void SubaperturesDataBase::AngularRemap::flip(const ocv::Orientation& _orientation) {
+
+	unsigned int N;
+	bool l_first_axis;
+	if (_orientation == ocv::horizontal) {
+		N = Nuv.first;
+		l_first_axis = !l_transposed;
+	} else if (_orientation == ocv::vertical) {
+		N = Nuv.second;
+		l_first_axis = l_transposed;
+	} else {
+		return;
+	}
+
+	if (N > 0) {
+		/*! Last view becomes first one, and walking direction is reversed.*/
+		if (l_first_axis) {
+			origin.first += step.first * int(N - 1);
+			step.first = -step.first;
+		} else {
+			origin.second += step.second * int(N - 1);
+			step.second = -step.second;
+		}
+	}
+
+}
+
+void SubaperturesDataBase::AngularRemap::transpose() {
+
+	l_transposed = !l_transposed;
+	std::swap(Nuv.first, Nuv.second);
+
+}
+
+bool SubaperturesDataBase::AngularRemap::crop(const Leupribo<unsigned int>& _Ncrop) {
+
+	if (_Ncrop[0] + _Ncrop[2] >= Nuv.first || _Ncrop[1] + _Ncrop[3] >= Nuv.second) {
+		return false;
+	}
+
+	/*! Offsets along u and v, expressed on grid axes.*/
+	const int offset_u = int(_Ncrop[0]);
+	const int offset_v = int(_Ncrop[1]);
+	if (l_transposed) {
+		origin.first += step.first * offset_v;
+		origin.second += step.second * offset_u;
+	} else {
+		origin.first += step.first * offset_u;
+		origin.second += step.second * offset_v;
+	}
+
+	Nuv.first -= _Ncrop[0] + _Ncrop[2];
+	Nuv.second -= _Ncrop[1] + _Ncrop[3];
+
+	return true;
+
+}
+
+bool SubaperturesDataBase::AngularRemap::remove(const Upair& _Nviews) {
+
+	if (Nuv.first == 0 || Nuv.second == 0 || (Nuv.first + _Nviews.first) % (_Nviews.first + 1) != 0 || (Nuv.second + _Nviews.second) % (_Nviews.second + 1) != 0) {
+		return false;
+	}
+
+	Nuv.first = (Nuv.first + _Nviews.first) / (_Nviews.first + 1);
+	Nuv.second = (Nuv.second + _Nviews.second) / (_Nviews.second + 1);
+
+	if (l_transposed) {
+		step.first *= int(_Nviews.second + 1);
+		step.second *= int(_Nviews.first + 1);
+	} else {
+		step.first *= int(_Nviews.first + 1);
+		step.second *= int(_Nviews.second + 1);
+	}
+
+	return true;
+
 }
\ No newline at end of file
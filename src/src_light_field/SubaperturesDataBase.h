@@ -88,9 +88,13 @@ public:
 	static unsigned int get_Nu(const TsubApT<Timg>& _subap);
 	template <class Timg>
 	static unsigned int get_Nv(const TsubApT<Timg>& _subap);
+	/*! Smallest number of rows, not lower than \p _Nrows, whose size is a multiple of \p _alignment bytes.*/
+	static unsigned int get_aligned_rows(const unsigned int _Nrows, const size_t _row_size, const size_t _alignment);
 
 	/*! Stores transformations applied on dimensions. Convenient to apply again exact same transforms.*/
 	struct DimensionsTransforms;
+	/*! Maps angular indices of a light field onto indices of its views grid. Lets angular flips, transposes, crops and views removal be applied without moving views.*/
+	struct AngularRemap;
 
 protected :
 	/*! Returns new angular dimensions and whether angular cropping is possible.*/
@@ -320,4 +324,49 @@ public :
 	const Fpair& get_image_scale() const;
 	const Fpair& get_baseline() const;
 
-};
\ No newline at end of file
+};
+
+///////// AngularRemap
+
+/*! Maps angular indices (u, v) onto indices of a views grid, as an affine transform along each axis (possibly swapped).
+Composing a flip, a transpose, a crop or a views removal only updates this mapping, in constant time.*/
+struct SubaperturesDataBase::AngularRemap {
+
+private:
+
+	/*! Angular dimensions seen through the mapping.*/
+	UVindices Nuv = { 0, 0 };
+	/*! Grid indices of view (0, 0).*/
+	Ipair origin = { 0, 0 };
+	/*! Steps between two consecutive views along first and second grid indices. Negative if flipped, larger than one if views are removed.*/
+	Ipair step = { 1, 1 };
+	/*! Whether u runs along second grid index and v along first one.*/
+	bool l_transposed = false;
+
+public:
+
+	/*! Identity mapping on a grid of size \p _Nuv.*/
+	void reset(const UVindices& _Nuv);
+	const UVindices& get_Nuv() const;
+	/*! Whether mapping is the identity on a grid of size \p _Nuv_grid. Ie, views are in their natural order.*/
+	bool is_identity(const UVindices& _Nuv_grid) const;
+
+	/*! Grid indices of view (\p u, \p v).*/
+	inline UVindices operator() (const unsigned int u, const unsigned int v) const;
+
+	/*! Flip along u direction if _orientation is ocv::horizontal, along v direction if _orientation is ocv::vertical.*/
+	void flip(const ocv::Orientation& _orientation);
+	void transpose();
+	/*! Crops views (left, up, right, bottom). Returns false, without modifying mapping, if no view would remain.*/
+	bool crop(const Leupribo<unsigned int>& _Ncrop);
+	/*! Removes _Nviews every _Nviews+1 views. Returns false, without modifying mapping, if angular dimensions don't match.*/
+	bool remove(const Upair& _Nviews);
+
+};
+
+inline UVindices SubaperturesDataBase::AngularRemap::operator() (const unsigned int u, const unsigned int v) const {
+
+	const int a = int(l_transposed ? v : u);
+	const int b = int(l_transposed ? u : v);
+	return UVindices((unsigned int)(origin.first + step.first * a), (unsigned int)(origin.second + step.second * b));
+}
\ No newline at end of file
@@ -12,6 +12,7 @@
 #include "HistMatch.h"
 #include "ocv_utils.h"/* For calcHist*/
 #include "SubaperturesData_ocv.h"
+#include "Tracing.h"
 
 template <class Timg>
 SubaperturesData<Timg>::SubaperturesData() {
@@ -47,6 +48,9 @@ void SubaperturesData<Timg>::clear() {
 
 	SubaperturesDataBase::clear();
 	subaperture_images.clear();
+	angular_remap.reset(UVindices(0, 0));
+	storage.release();
+	file_mapping.reset();
 }
 
 template <class Timg>
@@ -70,6 +74,11 @@ void SubaperturesData<Timg>::copyTo(SubaperturesData<Timg>& _subapertures) const
 
 	copyPropertiesTo(_subapertures);
 
+	/*! Copy keeps contiguous backend.*/
+	if (is_contiguous() && !(_subapertures.is_contiguous() && _subapertures.get_image_size() == get_image_size())) {
+		_subapertures.resize_contiguous(get_Nu(), get_Nv(), get_image_size());
+	}
+
 	for (unsigned int u = 0; u < get_Nu(); u++) {
 		for (unsigned int v = 0; v < get_Nv(); v++) {
 			if (ocv::is_valid((*this)(u, v))) {
@@ -101,6 +110,20 @@ void SubaperturesData<Timg>::copyTo(SubaperturesData<Timg_arg>& _subapertures) c
 
 }
 
+template <class Timg>
+template <class Timg_arg>
+void SubaperturesData<Timg>::convertTo(SubaperturesData<Timg_arg>& _subapertures, const std::vector<UVindices>& _indices) const {
+
+	copyPropertiesTo(_subapertures);
+
+	for (const UVindices& indices : _indices) {
+		if (check_uv_indices(indices) && ocv::is_valid((*this)[indices])) {
+			ocv::convertTo((*this)[indices], _subapertures[indices], true);
+		}
+	}
+
+}
+
 template <class Timg>
 template <class Timg_arg>
 void SubaperturesData<Timg>::copyPropertiesTo(SubaperturesData<Timg_arg>& _subapertures) const {
@@ -116,13 +139,13 @@ void SubaperturesData<Timg>::copyPropertiesTo(SubaperturesData<Timg_arg>& _subap
 template <class Timg>
 unsigned int SubaperturesData<Timg>::get_Nu() const {
 
-	return SubaperturesDataBase::get_Nu(subaperture_images);
+	return angular_remap.get_Nuv().first;
 }
 
 template <class Timg>
 unsigned int SubaperturesData<Timg>::get_Nv() const {
 
-	return SubaperturesDataBase::get_Nv(subaperture_images);
+	return angular_remap.get_Nuv().second;
 
 }
 
@@ -192,7 +215,115 @@ void SubaperturesData<Timg>::resize(const unsigned int _Nu, const unsigned int _
 template <class Timg>
 void SubaperturesData<Timg>::resize(const unsigned int _Nu, const unsigned int _Nv) {
 
+	/*! Views kept by resizing are the ones seen through angular remap.*/
+	compact_angular();
 	SubaperturesDataBase::resize(subaperture_images, _Nu, _Nv);
+	angular_remap.reset(UVindices(_Nu, _Nv));
+}
+
+template <class Timg>
+void SubaperturesData<Timg>::resize_contiguous(const unsigned int _Nu, const unsigned int _Nv, const cv::Size& _image_size) {
+
+	resize(_Nu, _Nv);
+
+	/*! Base address is aligned by OpenCV allocator. Padding rows are added to each view so that next one starts aligned too.*/
+	storage_view_rows = get_aligned_rows(_image_size.height, _image_size.width * sizeof(Tvec), storage_alignment);
+
+	storage.create(int(_Nu * _Nv * storage_view_rows), _image_size.width, Timg().type());
+
+	for (unsigned int u = 0; u < _Nu; u++) {
+		for (unsigned int v = 0; v < _Nv; v++) {
+			const int row_begin = int((u * _Nv + v) * storage_view_rows);
+			(*this)(u, v) = storage.rowRange(row_begin, row_begin + _image_size.height);
+		}
+	}
+
+}
+
+template <class Timg>
+bool SubaperturesData<Timg>::make_contiguous() {
+
+	if (is_contiguous()) {
+		return true;
+	}
+
+	if (this->empty() || !this->is_coherent() || this->is_sparse()) {
+		std::cout << "Can't use contiguous storage for an incoherent or sparse light field" << std::endl;
+		return false;
+	}
+
+	/*! Keep headers of current views while storage is allocated.*/
+	compact_angular();
+	TsubAp views = subaperture_images;
+	/*! Views may lie in current block (cropped or reordered) : a new one is allocated rather than reused.*/
+	storage.release();
+	resize_contiguous(get_Nu(), get_Nv(), get_image_size());
+
+	for (unsigned int u = 0; u < get_Nu(); u++) {
+		for (unsigned int v = 0; v < get_Nv(); v++) {
+			views[u][v].copyTo((*this)(u, v));
+		}
+	}
+
+	/*! Views no longer lie on mapped file.*/
+	file_mapping.reset();
+
+	return true;
+}
+
+template <class Timg>
+void SubaperturesData<Timg>::compact() {
+
+	compact_angular();
+
+	if (!storage.empty() && !this->empty() && this->is_coherent() && !this->is_sparse()) {
+		make_contiguous();
+	} else {
+		/*! Views on a mapped file are copied too, so that mapping can be released.*/
+		const bool l_mapped = bool(file_mapping);
+		for (unsigned int u = 0; u < get_Nu(); u++) {
+			for (unsigned int v = 0; v < get_Nv(); v++) {
+				if (ocv::is_valid((*this)(u, v)) && (l_mapped || (*this)(u, v).isSubmatrix())) {
+					(*this)(u, v) = (*this)(u, v).clone();
+				}
+			}
+		}
+		if (l_mapped) {
+			storage.release();
+			file_mapping.reset();
+		}
+	}
+
+}
+
+template <class Timg>
+bool SubaperturesData<Timg>::is_contiguous() const {
+
+	if (storage.empty() || this->empty() || storage.rows != int(get_Nu() * get_Nv() * storage_view_rows)) {
+		return false;
+	}
+
+	for (unsigned int u = 0; u < get_Nu(); u++) {
+		for (unsigned int v = 0; v < get_Nv(); v++) {
+			if ((*this)(u, v).data != storage.ptr(int((u * get_Nv() + v) * storage_view_rows)) || (*this)(u, v).cols != storage.cols) {
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+template <class Timg>
+const cv::Mat& SubaperturesData<Timg>::get_storage() const {
+
+	return storage;
+}
+
+template <class Timg>
+size_t SubaperturesData<Timg>::get_view_step() const {
+
+	return storage_view_rows * storage.step[0];
 }
 
 template <class Timg>
@@ -234,13 +365,15 @@ void SubaperturesData<Timg>::resize(const SubaperturesData<Timg2>& _subapertures
 template <class Timg>
 const Timg& SubaperturesData<Timg>::operator() (const unsigned int u, const unsigned int v) const {
 
-	return subaperture_images[u][v];
+	const UVindices uv = angular_remap(u, v);
+	return subaperture_images[uv.first][uv.second];
 }
 
 template <class Timg>
 Timg& SubaperturesData<Timg>::operator() (const unsigned int u, const unsigned int v) {
 
-	return subaperture_images[u][v];
+	const UVindices uv = angular_remap(u, v);
+	return subaperture_images[uv.first][uv.second];
 }
 
 template <class Timg>
@@ -388,13 +521,18 @@ std::pair<bool, bool> SubaperturesData<Timg>::get_full_image_transposes() const
 template <class Timg>
 void SubaperturesData<Timg>::crop_spatially(const Leupribo<unsigned int>& _Ncrop_pixels) {
 
+	if (_Ncrop_pixels == Leupribo<unsigned int>({ {0, 0, 0, 0} })) {
+		return;
+	}
+
+	/*! Views become region of interest headers on their current buffers : nothing is copied.*/
 	Timg image;
 	for (unsigned int u = 0; u < this->get_Nu(); u++) {
 		for (unsigned int v = 0; v < this->get_Nv(); v++) {
 
 			if (ocv::crop((*this)(u, v), image, _Ncrop_pixels)) {
 				if (ocv::is_valid(image)) {
-					image.copyTo((*this)(u, v));
+					(*this)(u, v) = image;
 				}
 			}
 			
@@ -406,6 +544,11 @@ void SubaperturesData<Timg>::crop_spatially(const Leupribo<unsigned int>& _Ncrop
 template <class Timg>
 void SubaperturesData<Timg>::crop_angular(const Leupribo<unsigned int>& _Ncrop_angular) {
 
+	if (angular_remap.crop(_Ncrop_angular)) {
+		return;
+	}
+
+	/*! Nothing left : same behaviour as resizing.*/
 	Leupribo<int> cropping_angular;
 	for (unsigned int i = 0; i < 4; i++) {
 		cropping_angular[i] = -(int)_Ncrop_angular[i];
@@ -466,10 +609,7 @@ void SubaperturesData<Timg>::apply_transforms(const SubaperturesDataBase::Dimens
 		} else if (_transforms.get_transforms()[t].get_type() == SubaperturesDataBase::DimensionsTransforms::Transform::FlipAngularVertical) {
 			flip_angular(ocv::vertical);
 		} else if (_transforms.get_transforms()[t].get_type() == SubaperturesDataBase::DimensionsTransforms::Transform::RemoveAngular) {
-			SubaperturesData<Timg> subapertures_coarsened;
-			if (get_coarsened(subapertures_coarsened, _transforms.get_transforms()[t].get_Nviews_removed())) {
-				subapertures_coarsened.copyTo(*this);
-			}
+			remove_angular(_transforms.get_transforms()[t].get_Nviews_removed());
 		} else if (_transforms.get_transforms()[t].get_type() == SubaperturesDataBase::DimensionsTransforms::Transform::CropAngular) {
 			crop_angular(_transforms.get_transforms()[t].get_Ncrop_angular());
 		} else if (_transforms.get_transforms()[t].get_type() == SubaperturesDataBase::DimensionsTransforms::Transform::CropSpatially) {
@@ -819,8 +959,8 @@ SubaperturesData<Timg>& SubaperturesData<Timg>::log() {
 template <class Timg>
 SubaperturesData<Timg>& SubaperturesData<Timg>::log(const Tvalue& _base) {
 
-	log();
-	*this /= Tvalue(std::log(_base));
+	/*! Single pass instead of log() followed by division. Logarithm of base is kept in double precision, also for integer values.*/
+	*this = SubaperturesExpression::log(*this) / std::log((double)_base);
 
 	return *this;
 }
@@ -854,17 +994,29 @@ SubaperturesData<Timg>& SubaperturesData<Timg>::exp() {
 template <class Timg>
 void SubaperturesData<Timg>::get_sum_image(Timg& _result) const {
 
-	for (unsigned int u = 0; u<get_Nu(); u++) {
-		for (unsigned int v = 0; v<get_Nv(); v++) {
+	if (this->empty() || !ocv::is_valid((*this)(0, 0))) {
+		return;
+	}
 
-			if (u == 0 && v == 0) {
-				(*this)(u, v).copyTo(_result);
-			} else {
-				cv::add(_result, (*this)(u, v), _result);
-			}
+	_result.create((*this)(0, 0).size());
+
+	/*! Parallel over tiles of rows. Each pixel sums views in (u, v) order : result doesn't depend on number of threads.*/
+	cv::parallel_for_(cv::Range(0, _result.rows), [&](const cv::Range& _range) {
+
+		Timg result_tile = _result.rowRange(_range.start, _range.end);
+
+		for (unsigned int u = 0; u < get_Nu(); u++) {
+			for (unsigned int v = 0; v < get_Nv(); v++) {
+
+				if (u == 0 && v == 0) {
+					(*this)(u, v).rowRange(_range.start, _range.end).copyTo(result_tile);
+				} else {
+					cv::add(result_tile, (*this)(u, v).rowRange(_range.start, _range.end), result_tile);
+				}
 
+			}
 		}
-	}
+	});
 
 }
 
@@ -889,20 +1041,33 @@ void SubaperturesData<Timg>::get_mean_image_weighted(Timg& _result, const Subape
 
 	if (size() == _weights.size() && get_image_size() == _weights.get_image_size()) {
 
-		for (unsigned int u = 0; u<get_Nu(); u++) {
-			for (unsigned int v = 0; v<get_Nv(); v++) {
+		if (this->empty()) {
+			return;
+		}
 
-				(*this)(u, v).copyTo(_buffer);
-				cv::multiply(_buffer, _weights(u, v), _buffer);
+		_result.create((*this)(0, 0).size());
+		_buffer.create(_result.size());
 
-				if (u == 0 && v == 0) {
-					_buffer.copyTo(_result);
-				} else {
-					cv::add(_result, _buffer, _result);
-				}
+		/*! Parallel over tiles of rows, each one using its rows of _buffer. Views are accumulated in (u, v) order.*/
+		cv::parallel_for_(cv::Range(0, _result.rows), [&](const cv::Range& _range) {
+
+			Timg result_tile = _result.rowRange(_range.start, _range.end);
+			Timg buffer_tile = _buffer.rowRange(_range.start, _range.end);
+
+			for (unsigned int u = 0; u < get_Nu(); u++) {
+				for (unsigned int v = 0; v < get_Nv(); v++) {
+
+					cv::multiply((*this)(u, v).rowRange(_range.start, _range.end), _weights(u, v).rowRange(_range.start, _range.end), buffer_tile);
+
+					if (u == 0 && v == 0) {
+						buffer_tile.copyTo(result_tile);
+					} else {
+						cv::add(result_tile, buffer_tile, result_tile);
+					}
 
+				}
 			}
-		}
+		});
 
 		_weights.get_sum_image(_buffer2);
 		cv::divide(_result, _buffer2, _result);
@@ -922,27 +1087,33 @@ void SubaperturesData<Timg>::get_highest_image_weighted(Timg& _result, ocv::Timg
 		_weights_highest.create(this->get_image_size());
 		_weights_highest = std::numeric_limits<ocv::Tvalue>::lowest();
 
-		for (unsigned int u = 0; u < this->get_Nu(); u++) {
-			for (unsigned int v = 0; v < this->get_Nv(); v++) {
+		/*! Parallel over tiles of rows. Views are compared in (u, v) order, so ties are resolved as in a serial pass.*/
+		cv::parallel_for_(cv::Range(0, _result.rows), [&](const cv::Range& _range) {
 
-				typename Timg::iterator it_val_result = _result.begin();
-				ocv::Timg1::iterator it_w_result = _weights_highest.begin();
-				typename Timg::const_iterator it_val = (*this)(u, v).begin();
-				ocv::Timg1::const_iterator it_w = _weights(u, v).begin();
+			for (unsigned int u = 0; u < this->get_Nu(); u++) {
+				for (unsigned int v = 0; v < this->get_Nv(); v++) {
 
-				for (; it_val != (*this)(u, v).end(); ++it_val, ++it_w, ++it_val_result, ++it_w_result) {
+					const Timg& image = (*this)(u, v);
+					const ocv::Timg1& weights = _weights(u, v);
 
-					if ((*it_w)[0] > (*it_w_result)[0]) {
+					for (int y = _range.start; y < _range.end; y++) {
 
-						*it_val_result = *it_val;
-						*it_w_result = *it_w;
+						const Tvec* row_val = image.template ptr<Tvec>(y);
+						const ocv::Timg1::value_type* row_w = weights.ptr<ocv::Timg1::value_type>(y);
+						Tvec* row_val_result = _result.template ptr<Tvec>(y);
+						ocv::Timg1::value_type* row_w_result = _weights_highest.ptr<ocv::Timg1::value_type>(y);
 
+						for (int x = 0; x < _result.cols; x++) {
+							if (row_w[x][0] > row_w_result[x][0]) {
+								row_val_result[x] = row_val[x];
+								row_w_result[x] = row_w[x];
+							}
+						}
 					}
 
 				}
-
 			}
-		}
+		});
 
 	} else {
 		std::cout << " SubaperturesData<Timg>::get_highest_image_weighted : _values and _weights have different dimensions" << std::endl;
@@ -1116,6 +1287,16 @@ void SubaperturesData<Timg>::angular_resize(const Leupribo<unsigned int>& _offse
 template <class Timg>
 void SubaperturesData<Timg>::angular_resize(const Leupribo<int>& _offsets) {
 
+	if (_offsets[0] <= 0 && _offsets[1] <= 0 && _offsets[2] <= 0 && _offsets[3] <= 0) {
+		Leupribo<unsigned int> Ncrop;
+		for (unsigned int i = 0; i < 4; i++) {
+			Ncrop[i] = (unsigned int)(-_offsets[i]);
+		}
+		if (angular_remap.crop(Ncrop)) {
+			return;
+		}
+	}
+
 	SubaperturesData<Timg> subapertures;
 	get_angular_resized(subapertures, _offsets);
 	subapertures.copyTo(*this);
@@ -1180,73 +1361,63 @@ void SubaperturesData<Timg>::get_angular_resized(SubaperturesData<Timg>& _subape
 template <class Timg>
 void SubaperturesData<Timg>::flip_angular(const ocv::Orientation& _orientation) {
 
-	Timg image_swap;
-	unsigned int N;
-	if (_orientation == ocv::horizontal) {
-
-		if (get_Nu() % 2 == 1) {
-			N = (get_Nu() - 1) / 2;
-		} else {
-			N = get_Nu()/ 2;
-		}
-		
-		for (unsigned int u = 0; u < N; u++) {
-			for (unsigned int v = 0; v < get_Nv(); v++) {
+	angular_remap.flip(_orientation);
 
-				image_swap = (*this)(u, v);
-				(*this)(u, v) = (*this)(get_Nu() - u - 1, v);
-				(*this)(get_Nu() - u - 1, v) = image_swap;
-
-			}
-		}
-
-	} else if (_orientation == ocv::vertical) {
+}
 
-		if (get_Nv() % 2 == 1) {
-			N = (get_Nv() - 1) / 2;
-		} else {
-			N = get_Nv() / 2;
-		}
+template <class Timg>
+void SubaperturesData<Timg>::transpose_angular() {
 
-		for (unsigned int v = 0; v < N; v++) {
-			for (unsigned int u = 0; u < get_Nu(); u++) {
+	angular_remap.transpose();
 
-				image_swap = (*this)(u, v);
-				(*this)(u, v) = (*this)(u, get_Nv() - v - 1);
-				(*this)(u, get_Nv() - v - 1) = image_swap;
+	l_invert_uv = !l_invert_uv;
+	std::swap(center_coordinates.first, center_coordinates.second);
+	std::swap(baseline.first, baseline.second);
+}
 
-			}
-		}
+template <class Timg>
+bool SubaperturesData<Timg>::remove_angular(const Upair& _n_images) {
 
+	if (!angular_remap.remove(_n_images)) {
+		std::cout << "Angular coarsening doesn't apply for angular size " << get_size_angular() << ", with number of images to remove equal to " << _n_images << std::endl;
+		return false;
 	}
 
+	/*! Update baseline when views are removed. Same as get_coarsened().*/
+	Fpair baseline = this->get_baseline();
+	baseline.first *= (_n_images.first + 1);
+	baseline.second *= (_n_images.second + 1);
+	baseline.second /= baseline.first;
+	baseline.first = 1.;
+	set_baseline(baseline);
+
+	return true;
 }
 
 template <class Timg>
-void SubaperturesData<Timg>::transpose_angular() {
-
-	unsigned int Nu = get_Nu();
-	unsigned int Nv = get_Nv();
+void SubaperturesData<Timg>::compact_angular() {
 
-	unsigned int N = std::max(get_Nu(), get_Nv());
-	resize(N, N);
-
-	Timg image_swap;
-	for (unsigned int u = 0; u < N; u++) {
-		for (unsigned int v = 0; v < u; v++) {
-
-			image_swap = (*this)(u, v);
-			(*this)(u, v) = (*this)(v, u);
-			(*this)(v, u) = image_swap;
+	if (is_angular_identity()) {
+		return;
+	}
 
+	TsubAp views;
+	SubaperturesDataBase::resize(views, get_Nu(), get_Nv());
+	for (unsigned int u = 0; u < get_Nu(); u++) {
+		for (unsigned int v = 0; v < get_Nv(); v++) {
+			views[u][v] = (*this)(u, v);
 		}
 	}
 
-	resize(Nv, Nu);
+	subaperture_images.swap(views);
+	angular_remap.reset(get_size_angular());
 
-	l_invert_uv = !l_invert_uv;
-	std::swap(center_coordinates.first, center_coordinates.second);
-	std::swap(baseline.first, baseline.second);
+}
+
+template <class Timg>
+bool SubaperturesData<Timg>::is_angular_identity() const {
+
+	return angular_remap.is_identity(UVindices(SubaperturesDataBase::get_Nu(subaperture_images), SubaperturesDataBase::get_Nv(subaperture_images)));
 }
 
 template <class Timg>
@@ -1317,16 +1488,22 @@ void SubaperturesData<Timg>::set_channel(int _nchannel, const SubaperturesData<
 template <class Timg>
 bool SubaperturesData<Timg>::has_nan() const {
 
-	bool l_has_nan = false;
-	for (unsigned int u = 0; u<get_Nu(); u++) {
-		for (unsigned int v = 0; v<get_Nv(); v++) {
-			if (!l_has_nan) {
-				l_has_nan = ocv::has_nan((*this)(u, v), "test");
-			}
+	/*! Views are checked in parallel, without display.*/
+	std::vector<char> l_has_nan_views(get_Nu() * get_Nv(), 0);
+	cv::parallel_for_(cv::Range(0, int(l_has_nan_views.size())), [&](const cv::Range& _range) {
+		for (int i = _range.start; i < _range.end; i++) {
+			l_has_nan_views[i] = ocv::has_nan((*this)(i / get_Nv(), i % get_Nv()));
+		}
+	});
+
+	/*! First view with NaN is checked again to display it.*/
+	for (unsigned int i = 0; i < l_has_nan_views.size(); i++) {
+		if (l_has_nan_views[i]) {
+			return ocv::has_nan((*this)(i / get_Nv(), i % get_Nv()), "test");
 		}
 	}
 
-	return l_has_nan;
+	return false;
 }
 
 template <class Timg>
@@ -1360,15 +1537,19 @@ std::vector<typename SubaperturesData<Timg>::Tvalue> SubaperturesData<Timg>::cal
 		range = _range;
 	}
 
-	cv::Mat histogram_image;
-	for (unsigned int u = 0; u<get_Nu(); u++) {
-		for (unsigned int v = 0; v<get_Nv(); v++) {
-			ocv::calcHist((*this)(u, v), histogram_image, 100, range);
-			if (u == 0 && v ==0) {
-				histogram_image.copyTo(_histogram);
-			} else {
-				_histogram += histogram_image;
-			}
+	/*! Histograms of views computed in parallel, then summed in (u, v) order : result doesn't depend on number of threads.*/
+	std::vector<cv::Mat> histograms_views(get_Nu() * get_Nv());
+	cv::parallel_for_(cv::Range(0, int(histograms_views.size())), [&](const cv::Range& _views_range) {
+		for (int i = _views_range.start; i < _views_range.end; i++) {
+			ocv::calcHist((*this)(i / get_Nv(), i % get_Nv()), histograms_views[i], _Nvalues, range);
+		}
+	});
+
+	for (unsigned int i = 0; i < histograms_views.size(); i++) {
+		if (i == 0) {
+			histograms_views[i].copyTo(_histogram);
+		} else {
+			_histogram += histograms_views[i];
 		}
 	}
 
@@ -1436,6 +1617,8 @@ bool SubaperturesData<Timg>::is_in_uv_range(const unsigned int u, const unsigned
 template <class Timg>
 bool SubaperturesData<Timg>::load(const SubaperturesLoader& _loader) {
 
+	Tracing::Scope scope("load");
+
 	SubaperturesDataBase::clear();
 
 	bool l_loaded;
@@ -1457,6 +1640,23 @@ bool SubaperturesData<Timg>::load(const SubaperturesLoader& _loader) {
 			}
 
 
+		} else if (_loader.is_container()) {
+
+			/*! Container stores light field after loader transforms (angular inversion, flips, cropping, scaling) : only preprocessing is applied.*/
+			if (load_container(_loader.get_parameters().LF_path)) {
+
+				preprocessing(_loader.get_parameters());
+
+				if (_loader.get_parameters().l_contiguous_storage) {
+					make_contiguous();
+				}
+
+				return !this->empty();
+
+			} else {
+				return false;
+			}
+
 		} else if (_loader.is_video()) {
 
 			std::cout << "No video management for loading light field" << std::endl;
@@ -1476,6 +1676,10 @@ bool SubaperturesData<Timg>::load(const SubaperturesLoader& _loader) {
 			preprocessing(_loader.get_parameters());
 
 			l_loaded = !this->empty();
+
+			if (l_loaded && _loader.get_parameters().l_contiguous_storage) {
+				make_contiguous();
+			}
 		}
 
 		return l_loaded;
@@ -1484,6 +1688,8 @@ bool SubaperturesData<Timg>::load(const SubaperturesLoader& _loader) {
 template <class Timg>
 bool SubaperturesData<Timg>::load(const SubaperturesLoader& _loader, const SubapertureBundle& _subapertures_bundle) {
 
+	Tracing::Scope scope("load");
+
 	/*! If subapertures is valid.*/
 	if (_subapertures_bundle) {
 
@@ -1495,6 +1701,10 @@ bool SubaperturesData<Timg>::load(const SubaperturesLoader& _loader, const Subap
 		loader_assign(_loader);
 		preprocessing(_loader.get_parameters());
 
+		if (_loader.get_parameters().l_contiguous_storage) {
+			make_contiguous();
+		}
+
 		return true;
 
 	} else {
@@ -1505,6 +1715,94 @@ bool SubaperturesData<Timg>::load(const SubaperturesLoader& _loader, const Subap
 
 }
 
+template <class Timg>
+bool SubaperturesData<Timg>::load_container(const std::string& _file_path) {
+
+	Tracing::Scope scope("load_container");
+
+	LightFieldContainer::Header header;
+	uchar* data = 0;
+	std::shared_ptr<void> mapping = LightFieldContainer::map(_file_path, header, data);
+
+	if (!mapping) {
+		return false;
+	}
+
+	clear();
+
+	this->name = header.name;
+	baseline = Fpair(header.baseline[0], header.baseline[1]);
+	center_coordinates = Fpair(header.center_coordinates[0], header.center_coordinates[1]);
+	l_invert_uv = (header.l_invert_uv != 0);
+
+	resize(header.Nu, header.Nv);
+	const cv::Size image_size(header.width, header.height);
+
+	if (header.type == Timg().type()) {
+
+		/*! Zero copy : contiguous storage is the mapped file.*/
+		storage = cv::Mat(int(header.Nu * header.Nv * header.view_rows), image_size.width, header.type, data);
+		storage_view_rows = header.view_rows;
+		file_mapping = mapping;
+
+		for (unsigned int u = 0; u < header.Nu; u++) {
+			for (unsigned int v = 0; v < header.Nv; v++) {
+				const int row_begin = int((u * header.Nv + v) * header.view_rows);
+				(*this)(u, v) = storage.rowRange(row_begin, row_begin + image_size.height);
+			}
+		}
+
+	} else {
+
+		const size_t view_step = LightFieldContainer::get_view_step(header);
+		for (unsigned int u = 0; u < header.Nu; u++) {
+			for (unsigned int v = 0; v < header.Nv; v++) {
+				cv::Mat view(image_size, header.type, data + (u * header.Nv + v) * view_step);
+				ocv::convertTo(view, (*this)(u, v), true);
+			}
+		}
+
+	}
+
+	return true;
+}
+
+template <class Timg>
+bool SubaperturesData<Timg>::write_container(const std::string& _file_path) const {
+
+	Tracing::Scope scope("write_container");
+
+	if (this->empty() || !this->is_coherent() || this->is_sparse()) {
+		std::cout << "Can't write an incoherent or sparse light field in a container" << std::endl;
+		return false;
+	}
+
+	const cv::Size image_size = get_image_size();
+
+	LightFieldContainer::Header header = LightFieldContainer::get_header();
+	header.Nu = get_Nu();
+	header.Nv = get_Nv();
+	header.width = image_size.width;
+	header.height = image_size.height;
+	header.type = Timg().type();
+	header.view_rows = get_aligned_rows(image_size.height, image_size.width * sizeof(Tvec), storage_alignment);
+	header.l_invert_uv = l_invert_uv;
+	header.baseline[0] = baseline.first;
+	header.baseline[1] = baseline.second;
+	header.center_coordinates[0] = center_coordinates.first;
+	header.center_coordinates[1] = center_coordinates.second;
+	this->name.copy(header.name, sizeof(header.name) - 1);
+
+	std::vector<cv::Mat> views;
+	for (unsigned int u = 0; u < get_Nu(); u++) {
+		for (unsigned int v = 0; v < get_Nv(); v++) {
+			views.push_back((*this)(u, v));
+		}
+	}
+
+	return LightFieldContainer::write(_file_path, header, views);
+}
+
 template <class Timg>
 void SubaperturesData<Timg>::loader_assign(const SubaperturesLoader& _loader) {
 
@@ -1544,6 +1842,16 @@ SubapertureBundle SubaperturesData<Timg>::get_subapertures_bundle(const Subapert
 
 	if (_loader.is_directory()) {
 
+		/*! Bundle resolved during a previous run, if directory is unchanged.*/
+		const std::string bundle_key = _loader.get_bundle_key();
+		if (_loader.get_parameters().l_bundle_manifest && subapertures_bundle.read_manifest(_loader.get_parameters().LF_path, bundle_key, _loader.get_parameters().l_recursive)) {
+
+			if (Misc::l_verbose_low) {
+				std::cout << "subapertures bundle read from manifest " << SubapertureBundle::get_manifest_path(_loader.get_parameters().LF_path) << std::endl;
+			}
+			return subapertures_bundle;
+		}
+
 		if (!_loader.get_parameters().l_auto_read) {
 			/*! If not autoread, configure SubapertureBundle with provided cfg file.*/
 			subapertures_bundle.set_parameters(_loader.get_parameters().reading_parameters);
@@ -1562,6 +1870,10 @@ SubapertureBundle SubaperturesData<Timg>::get_subapertures_bundle(const Subapert
 			std::cout << "subapertures bundle = " << subapertures_bundle << std::endl;
 		}
 
+		if (_loader.get_parameters().l_bundle_manifest && subapertures_bundle.Nuv_images > 0) {
+			subapertures_bundle.write_manifest(_loader.get_parameters().LF_path, bundle_key, _loader.get_parameters().l_recursive);
+		}
+
 	}
 
 	return subapertures_bundle;
@@ -1591,26 +1903,30 @@ void SubaperturesData<Timg>::load_SubapertureBundle(const SubapertureBundle& _su
 
 		if (uv_read != UVindices(-1, -1)) {
 
+			const bool l_valid_scale = _image_scale.first > 0 && _image_scale.second > 0;
+			if (!l_valid_scale) {
+				std::cout << "Can't rescale subapertures using parameter : image_scale = " << _image_scale << std::endl;
+			}
+
 #ifdef ENABLE_LIB_OPENEXR
 			if (Misc::get_file_extension(iterator->second) == ".exr") {
 				OpenEXR::imread(iterator->second, subaperture_images[uv_read.first][uv_read.second]);
+				if (l_valid_scale && ocv::is_valid(subaperture_images[uv_read.first][uv_read.second])) {
+					cv::resize(subaperture_images[uv_read.first][uv_read.second], subaperture_images[uv_read.first][uv_read.second], cv::Size(0, 0), _image_scale.first, _image_scale.second);
+				}
 			} else
 #endif
 			{
-				ocv::imread(iterator->second, subaperture_images[uv_read.first][uv_read.second]);
+				/*! Rescaling is done while decoding, before conversion to Timg.*/
+				if (l_valid_scale) {
+					ocv::imread(iterator->second, subaperture_images[uv_read.first][uv_read.second], _image_scale.first, _image_scale.second);
+				} else {
+					ocv::imread(iterator->second, subaperture_images[uv_read.first][uv_read.second]);
+				}
 			}
 
 			all_uv_read.push_back(uv_read);
 
-
-			if (_image_scale.first > 0 && _image_scale.second > 0) {
-				if (ocv::is_valid(subaperture_images[uv_read.first][uv_read.second])) {
-					cv::resize(subaperture_images[uv_read.first][uv_read.second], subaperture_images[uv_read.first][uv_read.second], cv::Size(0, 0), _image_scale.first, _image_scale.second);
-				}
-			} else {
-				std::cout << "Can't rescale subapertures using parameter : image_scale = " << _image_scale << std::endl;
-			}
-
 		}
 
 		if (Misc::l_verbose_high) Misc::display_progression(i_subaperture, _subapertures_bundle.Nuv_images);
@@ -1668,24 +1984,23 @@ void SubaperturesData<Timg>::preprocessing(const SubaperturesLoader::Parameters&
 
 	if (_loader_parameters.l_histogram_matching) {
 
-		cv::Mat_<cv::Vec3b> mat_center;
-		if (ocv::is_valid(get_center_image())) {
-			ocv::convertTo(get_center_image(), mat_center, true);
-			for (unsigned int u = 0; u < get_Nu(); u++) {
-				for (unsigned int v = 0; v < get_Nv(); v++) {
+		const Timg center_image = get_center_image();
+		if (ocv::is_valid(center_image)) {
+
+			/*! Reference CDF is computed once, then views are matched concurrently in their own type.*/
+			const ocv::Range<Tvalue> range = ocv::get_minmax_range(center_image);
+			const HistMatch::CDF reference_cdf = HistMatch::computeCDF(center_image, range.first, range.second);
 
-					if ((*this)(u, v).size() == get_center_image().size()) {
-						const cv::Mat* mask = 0;
-						cv::Mat_<cv::Vec3b> mat;
-						std::pair<double, double> scaling;
-						scaling = ocv::convertTo((*this)(u, v), mat, true);
-						HistMatch::histMatchRGB(mat, mask, mat_center, mask);
-						ocv::convertTo(mat, (*this)(u, v));
-						ocv::rescale_inv((*this)(u, v), scaling);
+			const unsigned int Nv = get_Nv();
+			cv::parallel_for_(cv::Range(0, int(get_Nu() * Nv)), [&](const cv::Range& _range) {
+				for (int i = _range.start; i < _range.end; i++) {
+					Timg& image = (*this)(i / Nv, i % Nv);
+					if (ocv::is_valid(image) && image.size() == center_image.size()) {
+						cv::Mat mat = image;
+						HistMatch::histMatch(mat, reference_cdf);
 					}
-					
 				}
-			}
+			});
 		}
 
 	}
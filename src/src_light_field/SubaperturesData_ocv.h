@@ -12,67 +12,78 @@
 /*! Meant to be included in SubaperturesData.h */
 
 namespace ocv {
+	/*! Extrema of views computed in parallel, then combined in (u, v) order.*/
 	template <class Tvec>
-	void minMaxLoc(const SubaperturesData< cv::Mat_<Tvec> >& _subapertures, Tvec* _min, Tvec* _max, const SubaperturesData<ocv::Tmask> _mask = SubaperturesData<ocv::Tmask>(), bool _l_inv_mask = false) {
+	void minMaxLoc(const SubaperturesData< cv::Mat_<Tvec> >& _subapertures, Tvec* _min, Tvec* _max, const SubaperturesData<ocv::Tmask>& _mask = SubaperturesData<ocv::Tmask>(), bool _l_inv_mask = false) {
 
 		*_min = Tvec::all(std::numeric_limits<typename Tvec::value_type>::max());
 		*_max = Tvec::all(std::numeric_limits<typename Tvec::value_type>::lowest());
 
-		Tvec min_image, max_image;
+		const unsigned int Nv = _subapertures.get_Nv();
+		const bool l_masked = _mask.has_same_dimensions(_subapertures);
+		std::vector<Tvec> min_images(_subapertures.get_Nu() * Nv), max_images(_subapertures.get_Nu() * Nv);
 
-		ocv::Tmask mask;
-		for (unsigned int u = 0; u<_subapertures.get_Nu(); u++) {
-			for (unsigned int v = 0; v<_subapertures.get_Nv(); v++) {
-				if (_mask.has_same_dimensions(_subapertures)) {
+		cv::parallel_for_(cv::Range(0, int(min_images.size())), [&](const cv::Range& _range) {
+			ocv::Tmask mask;
+			for (int i = _range.start; i < _range.end; i++) {
+				if (l_masked) {
 					if (_l_inv_mask) {
-						ocv::mask_inverse(_mask(u, v), mask);
+						ocv::mask_inverse(_mask(i / Nv, i % Nv), mask);
 					} else {
-						mask = _mask(u, v);
+						mask = _mask(i / Nv, i % Nv);
 					}
-					ocv::minMaxLoc(_subapertures(u, v), &min_image, &max_image, mask);
+					ocv::minMaxLoc(_subapertures(i / Nv, i % Nv), &min_images[i], &max_images[i], mask);
 				} else {
-					ocv::minMaxLoc(_subapertures(u, v), &min_image, &max_image);
+					ocv::minMaxLoc(_subapertures(i / Nv, i % Nv), &min_images[i], &max_images[i]);
 				}
-				for (unsigned int c = 0; c < Tvec::channels; c++) {
-					if (min_image[c] < (*_min)[c]) {
-						(*_min)[c] = min_image[c];
-					}
-					if (max_image[c] > (*_max)[c]) {
-						(*_max)[c] = max_image[c];
-					}
+			}
+		});
+
+		for (unsigned int i = 0; i < min_images.size(); i++) {
+			for (unsigned int c = 0; c < Tvec::channels; c++) {
+				if (min_images[i][c] < (*_min)[c]) {
+					(*_min)[c] = min_images[i][c];
+				}
+				if (max_images[i][c] > (*_max)[c]) {
+					(*_max)[c] = max_images[i][c];
 				}
 			}
 		}
 	}
 
 	template <class Tvec>
-	void minMaxLoc(const SubaperturesData< cv::Mat_<Tvec> >& _subapertures, typename Tvec::value_type* _min, typename Tvec::value_type* _max, const SubaperturesData<ocv::Tmask> _mask = SubaperturesData<ocv::Tmask>(), bool _l_inv_mask = false) {
+	void minMaxLoc(const SubaperturesData< cv::Mat_<Tvec> >& _subapertures, typename Tvec::value_type* _min, typename Tvec::value_type* _max, const SubaperturesData<ocv::Tmask>& _mask = SubaperturesData<ocv::Tmask>(), bool _l_inv_mask = false) {
 
 		*_min = std::numeric_limits<typename Tvec::value_type>::max();
 		*_max = std::numeric_limits<typename Tvec::value_type>::lowest();
 
-		typename Tvec::value_type min_image, max_image;
+		const unsigned int Nv = _subapertures.get_Nv();
+		const bool l_masked = _mask.has_same_dimensions(_subapertures);
+		std::vector<typename Tvec::value_type> min_images(_subapertures.get_Nu() * Nv), max_images(_subapertures.get_Nu() * Nv);
 
-		ocv::Tmask mask;
-		for (unsigned int u = 0; u<_subapertures.get_Nu(); u++) {
-			for (unsigned int v = 0; v<_subapertures.get_Nv(); v++) {
-				if (_mask.has_same_dimensions(_subapertures)) {
+		cv::parallel_for_(cv::Range(0, int(min_images.size())), [&](const cv::Range& _range) {
+			ocv::Tmask mask;
+			for (int i = _range.start; i < _range.end; i++) {
+				if (l_masked) {
 					if (_l_inv_mask) {
-						ocv::mask_inverse(_mask(u, v), mask);
+						ocv::mask_inverse(_mask(i / Nv, i % Nv), mask);
 					} else {
-						mask = _mask(u, v);
+						mask = _mask(i / Nv, i % Nv);
 					}
-					ocv::minMaxLoc(_subapertures(u, v), &min_image, &max_image, mask);
+					ocv::minMaxLoc(_subapertures(i / Nv, i % Nv), &min_images[i], &max_images[i], mask);
 				} else {
-					ocv::minMaxLoc(_subapertures(u, v), &min_image, &max_image);
-				}
-				if (min_image < *_min) {
-					*_min = (typename Tvec::value_type)min_image;
-				}
-				if (max_image > *_max) {
-					*_max = (typename Tvec::value_type)max_image;
+					ocv::minMaxLoc(_subapertures(i / Nv, i % Nv), &min_images[i], &max_images[i]);
 				}
 			}
+		});
+
+		for (unsigned int i = 0; i < min_images.size(); i++) {
+			if (min_images[i] < *_min) {
+				*_min = min_images[i];
+			}
+			if (max_images[i] > *_max) {
+				*_max = max_images[i];
+			}
 		}
 
 	}
@@ -92,7 +103,7 @@ namespace ocv {
 	}
 
 	template <class Tval, int Dim>
-	std::pair<Tval, Tval> get_minmax_range(const SubaperturesData< cv::Mat_< cv::Vec<Tval, Dim> > > _subapertures = SubaperturesData< cv::Mat_< cv::Vec<float, Dim> > >(), bool _l_image_range_saturate = false) {
+	std::pair<Tval, Tval> get_minmax_range(const SubaperturesData< cv::Mat_< cv::Vec<Tval, Dim> > >& _subapertures = SubaperturesData< cv::Mat_< cv::Vec<float, Dim> > >(), bool _l_image_range_saturate = false) {
 
 		std::pair<Tval, Tval> range;
 		range.first = std::numeric_limits<Tval>::lowest();
@@ -101,7 +112,7 @@ namespace ocv {
 	}
 
 	template <int Dim>
-	std::pair<float, float> get_minmax_range(const SubaperturesData< cv::Mat_< cv::Vec<float, Dim> > > _subapertures = SubaperturesData< cv::Mat_< cv::Vec<float, Dim> > >(), bool _l_image_range_saturate = false) {
+	std::pair<float, float> get_minmax_range(const SubaperturesData< cv::Mat_< cv::Vec<float, Dim> > >& _subapertures = SubaperturesData< cv::Mat_< cv::Vec<float, Dim> > >(), bool _l_image_range_saturate = false) {
 
 		std::pair<float, float> range;
 		if (_subapertures) {
@@ -126,7 +137,7 @@ namespace ocv {
 	}
 
 	template <int Dim>
-	std::pair<double, double> get_minmax_range(const SubaperturesData< cv::Mat_< cv::Vec<double, Dim> > > _subapertures = SubaperturesData< cv::Mat_< cv::Vec<float, Dim> > >(), bool _l_image_range_saturate = false) {
+	std::pair<double, double> get_minmax_range(const SubaperturesData< cv::Mat_< cv::Vec<double, Dim> > >& _subapertures = SubaperturesData< cv::Mat_< cv::Vec<float, Dim> > >(), bool _l_image_range_saturate = false) {
 
 		std::pair<double, double> range;
 		if (_subapertures) {
@@ -0,0 +1,422 @@
+/******************************************************************/
+/***            Pierre Allain, INRIA, February 2020				  */
+/***        GNU Affero General Public License version 3			  */
+/******************************************************************/
+
+#pragma once
+
+#include <cmath>
+#include <type_traits>
+#include <utility>
+
+template <class Timg>
+class SubaperturesData;
+
+/*! Lazy arithmetic on light fields. Operators on SubaperturesData (and scalars) build an expression tree instead of computing intermediate light fields.
+Assigning the expression to a SubaperturesData evaluates the whole chain in a single pass per pixel, views being processed in parallel :
+	result = (a * w + b) / w_sum;
+Operands are held by reference : an expression must be assigned within the statement that builds it.
+Single channel operands are broadcast on channels of multichannel ones (as a weight for instance).
+Integer values are computed in double precision and saturated back to their type, as OpenCV arithmetic does : a division by zero gives 0.
+Result takes properties (name, baseline...) of first light field operand.*/
+namespace SubaperturesExpression {
+
+	/*! Base of every node (CRTP), so that operators only apply to expressions.*/
+	template <class Texpr>
+	struct Expression {
+		const Texpr& derived() const { return static_cast<const Texpr&>(*this); }
+	};
+
+	///////// Per channel operations
+
+	/*! Type in which values of type T are computed : T itself for floating point values, double for integer ones.*/
+	template <class T>
+	struct Work {
+		typedef typename std::conditional<std::is_floating_point<T>::value, T, double>::type type;
+	};
+
+	/*! Computed value back to type T. Integer values are saturated, non finite ones giving 0.*/
+	template <class T, class Twork>
+	T to_value(const Twork _value) {
+		if (std::is_floating_point<T>::value) {
+			return (T)_value;
+		} else {
+			return std::isfinite((double)_value) ? cv::saturate_cast<T>(_value) : T(0);
+		}
+	}
+
+	struct Add { template <class T> static T apply(const T& _a, const T& _b) { return _a + _b; } };
+	struct Subtract { template <class T> static T apply(const T& _a, const T& _b) { return _a - _b; } };
+	struct Multiply { template <class T> static T apply(const T& _a, const T& _b) { return _a * _b; } };
+	struct Divide { template <class T> static T apply(const T& _a, const T& _b) { return _a / _b; } };
+
+	struct Sqrt { template <class T> static T apply(const T& _a, const double&) { return (T)std::sqrt(_a); } };
+	struct Log { template <class T> static T apply(const T& _a, const double&) { return (T)std::log(_a); } };
+	struct Exp { template <class T> static T apply(const T& _a, const double&) { return (T)std::exp(_a); } };
+	struct Abs { template <class T> static T apply(const T& _a, const double&) { return (T)std::abs(_a); } };
+	struct Inverse { template <class T> static T apply(const T& _a, const double&) { return (T)(1. / _a); } };
+	struct Pow { template <class T> static T apply(const T& _a, const double& _power) { return (T)std::pow(_a, _power); } };
+
+	/*! Same number of channels.*/
+	template <class Top, class T, int Dim>
+	cv::Vec<T, Dim> apply(const cv::Vec<T, Dim>& _a, const cv::Vec<T, Dim>& _b) {
+		cv::Vec<T, Dim> result;
+		for (int c = 0; c < Dim; c++) {
+			result[c] = to_value<T>(Top::apply((typename Work<T>::type)_a[c], (typename Work<T>::type)_b[c]));
+		}
+		return result;
+	}
+
+	/*! Single channel \p _b broadcast on channels of \p _a.*/
+	template <class Top, class T, int Dim>
+	typename std::enable_if<(Dim > 1), cv::Vec<T, Dim> >::type apply(const cv::Vec<T, Dim>& _a, const cv::Vec<T, 1>& _b) {
+		cv::Vec<T, Dim> result;
+		for (int c = 0; c < Dim; c++) {
+			result[c] = to_value<T>(Top::apply((typename Work<T>::type)_a[c], (typename Work<T>::type)_b[0]));
+		}
+		return result;
+	}
+
+	/*! Single channel \p _a broadcast on channels of \p _b.*/
+	template <class Top, class T, int Dim>
+	typename std::enable_if<(Dim > 1), cv::Vec<T, Dim> >::type apply(const cv::Vec<T, 1>& _a, const cv::Vec<T, Dim>& _b) {
+		cv::Vec<T, Dim> result;
+		for (int c = 0; c < Dim; c++) {
+			result[c] = to_value<T>(Top::apply((typename Work<T>::type)_a[0], (typename Work<T>::type)_b[c]));
+		}
+		return result;
+	}
+
+	template <class Top, class T, int Dim>
+	cv::Vec<T, Dim> apply(const cv::Vec<T, Dim>& _a, const double& _b) {
+		cv::Vec<T, Dim> result;
+		for (int c = 0; c < Dim; c++) {
+			result[c] = to_value<T>(Top::apply((typename Work<T>::type)_a[c], (typename Work<T>::type)_b));
+		}
+		return result;
+	}
+
+	template <class Top, class T, int Dim>
+	cv::Vec<T, Dim> apply(const double& _a, const cv::Vec<T, Dim>& _b) {
+		cv::Vec<T, Dim> result;
+		for (int c = 0; c < Dim; c++) {
+			result[c] = to_value<T>(Top::apply((typename Work<T>::type)_a, (typename Work<T>::type)_b[c]));
+		}
+		return result;
+	}
+
+	///////// Nodes
+	/*! Every node provides :
+	- Tvec : type of values.
+	- get_dimensions : angular and spatial size of operands, false if they don't match.
+	- is_valid(u, v) : whether view (u, v) exists in every operand.
+	- Bound : node bound to a view, evaluated row by row (row(y), then [x]). Bound nodes are created per view, thus per thread.
+	- copy_properties_to : copies properties of first light field operand to output, false if there is none.*/
+
+	template <class Timg>
+	struct Terminal : public Expression< Terminal<Timg> > {
+
+		typedef typename Timg::value_type Tvec;
+
+		const SubaperturesData<Timg>& subapertures;
+
+		Terminal(const SubaperturesData<Timg>& _subapertures) : subapertures(_subapertures) {}
+
+		bool get_dimensions(UVindices& _Nuv, cv::Size& _image_size) const {
+			if (_Nuv == UVindices(0, 0)) {
+				_Nuv = subapertures.get_size_angular();
+				_image_size = subapertures.get_image_size();
+				return true;
+			}
+			return _Nuv == subapertures.get_size_angular() && _image_size == subapertures.get_image_size();
+		}
+
+		bool is_valid(const unsigned int u, const unsigned int v) const {
+			return ocv::is_valid(subapertures(u, v));
+		}
+
+		template <class Timg_output>
+		bool copy_properties_to(SubaperturesData<Timg_output>& _subapertures) const {
+			/*! Output being this operand already has its properties.*/
+			if ((const void*)&subapertures != (const void*)&_subapertures) {
+				subapertures.copyPropertiesTo(_subapertures);
+			}
+			return true;
+		}
+
+		struct Bound {
+			const Timg& image;
+			const Tvec* row_data;
+			Bound(const Timg& _image) : image(_image), row_data(0) {}
+			void row(const int y) { row_data = image.template ptr<Tvec>(y); }
+			const Tvec& operator[] (const int x) const { return row_data[x]; }
+		};
+
+		Bound bind(const unsigned int u, const unsigned int v) const {
+			return Bound(subapertures(u, v));
+		}
+
+	};
+
+	struct Scalar : public Expression<Scalar> {
+
+		typedef double Tvec;
+
+		double value;
+
+		Scalar(const double _value) : value(_value) {}
+
+		bool get_dimensions(UVindices&, cv::Size&) const { return true; }
+		bool is_valid(const unsigned int, const unsigned int) const { return true; }
+
+		template <class Timg_output>
+		bool copy_properties_to(SubaperturesData<Timg_output>&) const { return false; }
+
+		struct Bound {
+			double value;
+			void row(const int) {}
+			double operator[] (const int) const { return value; }
+		};
+
+		Bound bind(const unsigned int, const unsigned int) const {
+			Bound bound;
+			bound.value = value;
+			return bound;
+		}
+
+	};
+
+	template <class Top, class Tleft, class Tright>
+	struct Binary : public Expression< Binary<Top, Tleft, Tright> > {
+
+		typedef decltype(apply<Top>(std::declval<typename Tleft::Tvec>(), std::declval<typename Tright::Tvec>())) Tvec;
+
+		Tleft left;
+		Tright right;
+
+		Binary(const Tleft& _left, const Tright& _right) : left(_left), right(_right) {}
+
+		bool get_dimensions(UVindices& _Nuv, cv::Size& _image_size) const {
+			return left.get_dimensions(_Nuv, _image_size) && right.get_dimensions(_Nuv, _image_size);
+		}
+
+		bool is_valid(const unsigned int u, const unsigned int v) const {
+			return left.is_valid(u, v) && right.is_valid(u, v);
+		}
+
+		template <class Timg_output>
+		bool copy_properties_to(SubaperturesData<Timg_output>& _subapertures) const {
+			return left.copy_properties_to(_subapertures) || right.copy_properties_to(_subapertures);
+		}
+
+		struct Bound {
+			typename Tleft::Bound left;
+			typename Tright::Bound right;
+			void row(const int y) { left.row(y); right.row(y); }
+			Tvec operator[] (const int x) const { return apply<Top>(left[x], right[x]); }
+		};
+
+		Bound bind(const unsigned int u, const unsigned int v) const {
+			return Bound{ left.bind(u, v), right.bind(u, v) };
+		}
+
+	};
+
+	template <class Top, class Targ>
+	struct Unary : public Expression< Unary<Top, Targ> > {
+
+		typedef typename Targ::Tvec Tvec;
+
+		Targ argument;
+		/*! Parameter of operation (power for instance).*/
+		double parameter;
+
+		Unary(const Targ& _argument, const double _parameter = 0.) : argument(_argument), parameter(_parameter) {}
+
+		bool get_dimensions(UVindices& _Nuv, cv::Size& _image_size) const {
+			return argument.get_dimensions(_Nuv, _image_size);
+		}
+
+		bool is_valid(const unsigned int u, const unsigned int v) const {
+			return argument.is_valid(u, v);
+		}
+
+		template <class Timg_output>
+		bool copy_properties_to(SubaperturesData<Timg_output>& _subapertures) const {
+			return argument.copy_properties_to(_subapertures);
+		}
+
+		struct Bound {
+			typename Targ::Bound argument;
+			double parameter;
+			void row(const int y) { argument.row(y); }
+			Tvec operator[] (const int x) const {
+				const Tvec value = argument[x];
+				Tvec result;
+				typedef typename Tvec::value_type T;
+				for (int c = 0; c < Tvec::channels; c++) {
+					result[c] = to_value<T>(Top::apply((typename Work<T>::type)value[c], parameter));
+				}
+				return result;
+			}
+		};
+
+		Bound bind(const unsigned int u, const unsigned int v) const {
+			return Bound{ argument.bind(u, v), parameter };
+		}
+
+	};
+
+	///////// Operands
+
+	/*! Node type of an operand : SubaperturesData, expression or arithmetic scalar.*/
+	template <class T, class Tenable = void>
+	struct Operand {
+		static const bool l_valid = false;
+		static const bool l_light_field = false;
+	};
+
+	template <class Timg>
+	struct Operand< SubaperturesData<Timg> > {
+		static const bool l_valid = true;
+		static const bool l_light_field = true;
+		typedef Terminal<Timg> Tnode;
+		static Tnode get(const SubaperturesData<Timg>& _subapertures) { return Tnode(_subapertures); }
+	};
+
+	template <class Texpr>
+	struct Operand<Texpr, typename std::enable_if<std::is_base_of<Expression<Texpr>, Texpr>::value>::type> {
+		static const bool l_valid = true;
+		static const bool l_light_field = !std::is_same<Texpr, Scalar>::value;
+		typedef Texpr Tnode;
+		static const Tnode& get(const Texpr& _expression) { return _expression; }
+	};
+
+	template <class T>
+	struct Operand<T, typename std::enable_if<std::is_arithmetic<T>::value>::type> {
+		static const bool l_valid = true;
+		static const bool l_light_field = false;
+		typedef Scalar Tnode;
+		static Tnode get(const T& _value) { return Tnode((double)_value); }
+	};
+
+	/*! Whether binary operator applies : both operands are valid and at least one is a light field.*/
+	template <class Tleft, class Tright>
+	struct IsBinary {
+		static const bool value = Operand<Tleft>::l_valid && Operand<Tright>::l_valid && (Operand<Tleft>::l_light_field || Operand<Tright>::l_light_field);
+	};
+
+	template <class Top, class Tleft, class Tright>
+	using BinaryOf = Binary<Top, typename Operand<Tleft>::Tnode, typename Operand<Tright>::Tnode>;
+
+	template <class Top, class Targ>
+	using UnaryOf = typename std::enable_if<Operand<Targ>::l_light_field, Unary<Top, typename Operand<Targ>::Tnode> >::type;
+
+	template <class Top, class Tleft, class Tright>
+	BinaryOf<Top, Tleft, Tright> make_binary(const Tleft& _left, const Tright& _right) {
+		return BinaryOf<Top, Tleft, Tright>(Operand<Tleft>::get(_left), Operand<Tright>::get(_right));
+	}
+
+	template <class Targ> UnaryOf<Sqrt, Targ> sqrt(const Targ& _argument) { return UnaryOf<Sqrt, Targ>(Operand<Targ>::get(_argument)); }
+	template <class Targ> UnaryOf<Log, Targ> log(const Targ& _argument) { return UnaryOf<Log, Targ>(Operand<Targ>::get(_argument)); }
+	template <class Targ> UnaryOf<Exp, Targ> exp(const Targ& _argument) { return UnaryOf<Exp, Targ>(Operand<Targ>::get(_argument)); }
+	template <class Targ> UnaryOf<Abs, Targ> abs(const Targ& _argument) { return UnaryOf<Abs, Targ>(Operand<Targ>::get(_argument)); }
+	template <class Targ> UnaryOf<Inverse, Targ> inverse(const Targ& _argument) { return UnaryOf<Inverse, Targ>(Operand<Targ>::get(_argument)); }
+	template <class Targ> UnaryOf<Pow, Targ> pow(const Targ& _argument, const double _power) { return UnaryOf<Pow, Targ>(Operand<Targ>::get(_argument), _power); }
+
+	/*! Evaluates \p _expression in \p _subapertures, in a single pass per view. Views are processed in parallel.
+	\p _subapertures can be an operand of expression : pixels are read before being written. Returns false if operands dimensions don't match.*/
+	template <class Timg, class Texpr>
+	bool evaluate(const Expression<Texpr>& _expression, SubaperturesData<Timg>& _subapertures);
+
+}
+
+template <class Tleft, class Tright, class = typename std::enable_if<SubaperturesExpression::IsBinary<Tleft, Tright>::value>::type>
+SubaperturesExpression::BinaryOf<SubaperturesExpression::Add, Tleft, Tright> operator+(const Tleft& _left, const Tright& _right) {
+	return SubaperturesExpression::make_binary<SubaperturesExpression::Add>(_left, _right);
+}
+
+template <class Tleft, class Tright, class = typename std::enable_if<SubaperturesExpression::IsBinary<Tleft, Tright>::value>::type>
+SubaperturesExpression::BinaryOf<SubaperturesExpression::Subtract, Tleft, Tright> operator-(const Tleft& _left, const Tright& _right) {
+	return SubaperturesExpression::make_binary<SubaperturesExpression::Subtract>(_left, _right);
+}
+
+template <class Tleft, class Tright, class = typename std::enable_if<SubaperturesExpression::IsBinary<Tleft, Tright>::value>::type>
+SubaperturesExpression::BinaryOf<SubaperturesExpression::Multiply, Tleft, Tright> operator*(const Tleft& _left, const Tright& _right) {
+	return SubaperturesExpression::make_binary<SubaperturesExpression::Multiply>(_left, _right);
+}
+
+template <class Tleft, class Tright, class = typename std::enable_if<SubaperturesExpression::IsBinary<Tleft, Tright>::value>::type>
+SubaperturesExpression::BinaryOf<SubaperturesExpression::Divide, Tleft, Tright> operator/(const Tleft& _left, const Tright& _right) {
+	return SubaperturesExpression::make_binary<SubaperturesExpression::Divide>(_left, _right);
+}
+
+template <class Timg, class Texpr>
+bool SubaperturesExpression::evaluate(const Expression<Texpr>& _expression, SubaperturesData<Timg>& _subapertures) {
+
+	typedef typename Timg::value_type Tvec;
+	static_assert(std::is_same<typename Texpr::Tvec, Tvec>::value, "SubaperturesExpression::evaluate : expression and light field value types differ");
+
+	const Texpr& expression = _expression.derived();
+
+	UVindices Nuv(0, 0);
+	cv::Size image_size(0, 0);
+	if (!expression.get_dimensions(Nuv, image_size)) {
+		std::cout << "SubaperturesExpression::evaluate : Wrong subapertures sizes" << std::endl;
+		return false;
+	}
+
+	expression.copy_properties_to(_subapertures);
+
+	/*! Output slots are allocated serially. Already allocated views (operands for instance) are written in place.*/
+	if (_subapertures.get_size_angular() != Nuv) {
+		_subapertures.resize(Nuv.first, Nuv.second);
+	}
+	for (unsigned int u = 0; u < Nuv.first; u++) {
+		for (unsigned int v = 0; v < Nuv.second; v++) {
+			if (expression.is_valid(u, v)) {
+				_subapertures(u, v).create(image_size);
+			}
+		}
+	}
+
+	cv::parallel_for_(cv::Range(0, int(Nuv.first * Nuv.second)), [&](const cv::Range& _range) {
+		for (int i = _range.start; i < _range.end; i++) {
+
+			const unsigned int u = i / Nuv.second;
+			const unsigned int v = i % Nuv.second;
+
+			if (expression.is_valid(u, v)) {
+				typename Texpr::Bound bound = expression.bind(u, v);
+				Timg& image = _subapertures(u, v);
+				for (int y = 0; y < image_size.height; y++) {
+					bound.row(y);
+					Tvec* row = image.template ptr<Tvec>(y);
+					for (int x = 0; x < image_size.width; x++) {
+						row[x] = bound[x];
+					}
+				}
+			}
+		}
+	});
+
+	/*! Sparse operands : missing views are missing in result too.*/
+	for (unsigned int u = 0; u < Nuv.first; u++) {
+		for (unsigned int v = 0; v < Nuv.second; v++) {
+			if (!expression.is_valid(u, v)) {
+				_subapertures(u, v).release();
+			}
+		}
+	}
+
+	return true;
+}
+
+template <class Timg>
+template <class Texpr>
+SubaperturesData<Timg>& SubaperturesData<Timg>::operator=(const SubaperturesExpression::Expression<Texpr>& _expression) {
+
+	SubaperturesExpression::evaluate(_expression, *this);
+
+	return *this;
+}
@@ -5,6 +5,7 @@
 
 #include "SubaperturesLoader.h"
 #include "misc_funcs.h"
+#include "LightFieldContainer.h"
 
 const Fpair SubaperturesLoader::center_coordinates_default() {
 	static const Fpair _center_coordinates_default(-1., -1.);
@@ -47,15 +48,67 @@ bool SubaperturesLoader::is_video() const {
 	return l_video;
 }
 
+bool SubaperturesLoader::is_container() const {
+
+	return l_container;
+}
+
 const std::string& SubaperturesLoader::get_LF_name() const {
 
 	return LF_name;
 }
 
+std::string SubaperturesLoader::get_bundle_key() const {
+
+	std::ostringstream key;
+	key << parameters.l_auto_read << " " << parameters.l_recursive << " " << parameters.time_index;
+	if (parameters.l_auto_read) {
+		key << " " << parameters.Nimages_auto << " " << parameters.coef_std_Nimages_auto << " " << parameters.coef_std_ratio_auto;
+	} else {
+		const SubapertureBundle::Parameters& reading_parameters = parameters.reading_parameters;
+		key << " " << reading_parameters.l_single_index_for_subapertures << " " << reading_parameters.UVdims.first << " " << reading_parameters.UVdims.second << " " << reading_parameters.l_begin0;
+		for (unsigned int position : reading_parameters.uvt_position_in_name) {
+			key << " " << position;
+		}
+	}
+	key << " |";
+	for (const std::string& filter_string : parameters.filter_strings) {
+		key << " " << filter_string;
+	}
+
+	return key.str();
+}
+
+std::string SubaperturesLoader::get_load_key() const {
+
+	std::ostringstream key;
+	key << parameters.LF_path << " | " << get_bundle_key() << " | ";
+	/*! Bundle key may omit some of them depending on reading mode, while they also matter for videos and containers.*/
+	key << parameters.l_recursive << " " << parameters.time_index << " " << parameters.Nimages_auto;
+	for (const std::string& filter_string : parameters.filter_strings) {
+		key << " " << filter_string;
+	}
+	key << " | ";
+	key << parameters.l_invert_uv << " " << parameters.uv_axis_coef.first << " " << parameters.uv_axis_coef.second;
+	key << " " << parameters.center_coordinates.first << " " << parameters.center_coordinates.second;
+	key << " " << parameters.image_scale.first << " " << parameters.image_scale.second;
+	for (unsigned int offset : parameters.subaperture_offsets) {
+		key << " " << offset;
+	}
+	key << " " << parameters.angular_modulo.first << " " << parameters.angular_modulo.second << " " << parameters.l_histogram_matching;
+	for (unsigned int Npixels : parameters.Ncrop_pixels) {
+		key << " " << Npixels;
+	}
+	key << " " << parameters.l_contiguous_storage;
+
+	return key.str();
+}
+
 void SubaperturesLoader::deduce() {
 
 	l_directory = Misc::is_directory(parameters.LF_path);
 	l_video = Misc::is_video_file(parameters.LF_path);
+	l_container = !l_directory && LightFieldContainer::is_container(parameters.LF_path);
 
 	/*! Finds last folder separator and extract last name.*/
 	LF_name = Misc::extract_name_from_path(parameters.LF_path);
@@ -55,6 +55,10 @@ public :
 		std::vector<std::string> filter_strings = {"mask"};
 		/*! Wether to display sub-apertures when loaded or not.*/
 		bool l_display_subapertures = false;
+		/*! Whether loaded subapertures are stored in a single aligned allocation (see SubaperturesData::make_contiguous).*/
+		bool l_contiguous_storage = false;
+		/*! Whether SubapertureBundle resolved from a directory is cached in a manifest of data path, and reused while directory (and its sub-directories if l_recursive) is unchanged.*/
+		bool l_bundle_manifest = false;
 		
 	};
 
@@ -67,6 +71,8 @@ private :
 	bool l_directory;
 	/*! Wether if LF_path is a video file.*/
 	bool l_video;
+	/*! Wether if LF_path is a LightFieldContainer file.*/
+	bool l_container;
 	/*! Name of LF extracted from LF_path.*/
 	std::string LF_name;
 	/*! Extension of LF file (if file).*/
@@ -85,7 +91,12 @@ public:
 
 	bool is_directory() const;
 	bool is_video() const;
+	bool is_container() const;
 	const std::string& get_LF_name() const;
+	/*! Single line description of parameters determining SubapertureBundle of directory. Identifies validity of bundle manifest.*/
+	std::string get_bundle_key() const;
+	/*! Single line description of every parameter determining loaded light field (path included). Two loaders with same key load the same light field.*/
+	std::string get_load_key() const;
 
 	static const Fpair center_coordinates_default();
 
@@ -28,7 +28,9 @@ const std::map<ConfigParametersSpecializations<SubaperturesLoader>::ParametersId
 { coef_std_Nimages_auto, "coef_std_Nimages_auto" },
 { coef_std_ratio_auto, "coef_std_ratio_auto" },
 { filter_strings, "filter_strings" },
-{ l_display_subapertures, "l_display_subapertures" }
+{ l_display_subapertures, "l_display_subapertures" },
+{ l_contiguous_storage, "l_contiguous_storage" },
+{ l_bundle_manifest, "l_bundle_manifest" }
 };
 
 
@@ -154,6 +156,14 @@ bool ConfigParametersSpecializations<SubaperturesLoader>::set_value(Subapertures
 
 		l_keep_reading = ConfigParameter::read(_parameters.l_display_subapertures, _sub_strings, _parameter_name);
 
+	} else if (_parameter_name == all_parameters.at(ParametersId::l_contiguous_storage)) {
+
+		l_keep_reading = ConfigParameter::read(_parameters.l_contiguous_storage, _sub_strings, _parameter_name);
+
+	} else if (_parameter_name == all_parameters.at(ParametersId::l_bundle_manifest)) {
+
+		l_keep_reading = ConfigParameter::read(_parameters.l_bundle_manifest, _sub_strings, _parameter_name);
+
 	} else {
 
 		ConfigBase::display_unknown_parameter(_parameter_name);
@@ -28,7 +28,9 @@ private:
 		coef_std_Nimages_auto,
 		coef_std_ratio_auto,
 		filter_strings,
-		l_display_subapertures
+		l_display_subapertures,
+		l_contiguous_storage,
+		l_bundle_manifest
 	};
 	static const std::map<ParametersId, std::string> all_parameters;
 
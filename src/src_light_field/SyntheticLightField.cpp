@@ -0,0 +1,187 @@
+/******************************************************************/
+/***            Pierre Allain, INRIA, February 2020				  */
+/***        GNU Affero General Public License version 3			  */
+/******************************************************************/
+
+#include "SyntheticLightField.h"
+
+SyntheticLightField::SyntheticLightField() {
+
+	build_planes();
+}
+
+SyntheticLightField::SyntheticLightField(const Parameters& _parameters) {
+
+	set_parameters(_parameters);
+}
+
+SyntheticLightField::~SyntheticLightField() {
+
+}
+
+void SyntheticLightField::set_parameters(const Parameters& _parameters) {
+
+	parameters = _parameters;
+	build_planes();
+}
+
+const SyntheticLightField::Parameters& SyntheticLightField::get_parameters() const {
+
+	return parameters;
+}
+
+UVindices SyntheticLightField::get_center_indices() const {
+
+	return UVindices(parameters.angular_size.first / 2, parameters.angular_size.second / 2);
+}
+
+size_t SyntheticLightField::get_Nplanes(const bool _l_object) const {
+
+	if (_l_object) {
+		return planes.size();
+	} else {
+		return planes.size() - 1;
+	}
+}
+
+void SyntheticLightField::build_planes() {
+
+	cv::Size image_size(parameters.image_size.first, parameters.image_size.second);
+	/*! At least background and object.*/
+	unsigned int Nplanes = std::max(parameters.Nplanes, 2u);
+
+	cv::RNG rng(parameters.seed);
+
+	planes.resize(Nplanes);
+
+	for (unsigned int i = 0; i < Nplanes; i++) {
+
+		Plane& plane = planes[i];
+
+		plane.disparity = parameters.disparity_range.first;
+		plane.disparity += (parameters.disparity_range.second - parameters.disparity_range.first) * double(i) / double(Nplanes - 1);
+
+		/*! Colored smooth noise.*/
+		plane.texture.create(image_size);
+		rng.fill(plane.texture, cv::RNG::UNIFORM, cv::Scalar::all(0.), cv::Scalar::all(1.));
+		if (parameters.texture_sigma > 0.) {
+			cv::GaussianBlur(plane.texture, plane.texture, cv::Size(0, 0), parameters.texture_sigma);
+		}
+		cv::normalize(plane.texture, plane.texture, 0., 1., cv::NORM_MINMAX);
+		cv::Scalar color(rng.uniform(0.3, 1.), rng.uniform(0.3, 1.), rng.uniform(0.3, 1.));
+		cv::multiply(plane.texture, color, plane.texture);
+
+		plane.support.create(image_size);
+		if (i == 0) {
+			/*! Background covers whole image.*/
+			plane.support = 1.;
+		} else if (i + 1 == Nplanes) {
+			/*! Object to remove : centered disk.*/
+			plane.support = 0.;
+			int radius = (int)std::round(std::sqrt(parameters.mask_ratio * image_size.area() / CV_PI));
+			cv::circle(plane.support, cv::Point(image_size.width / 2, image_size.height / 2), radius, cv::Scalar(1.), -1);
+		} else {
+			plane.support = 0.;
+			int width = rng.uniform(image_size.width / 5, std::max(image_size.width * 3 / 5, image_size.width / 5 + 1));
+			int height = rng.uniform(image_size.height / 5, std::max(image_size.height * 3 / 5, image_size.height / 5 + 1));
+			cv::Point corner(rng.uniform(0, std::max(image_size.width - width, 1)), rng.uniform(0, std::max(image_size.height - height, 1)));
+			cv::rectangle(plane.support, cv::Rect(corner, cv::Size(width, height)), cv::Scalar(1.), -1);
+		}
+	}
+
+}
+
+void SyntheticLightField::render(const unsigned int u, const unsigned int v, ocv::Timg& _image, const bool _l_object) const {
+
+	cv::Size image_size(parameters.image_size.first, parameters.image_size.second);
+	UVindices center_indices = get_center_indices();
+
+	_image.create(image_size);
+	_image = ocv::Timg::value_type::all(0.);
+
+	ocv::Timg texture;
+	ocv::Timg1 support;
+	cv::Matx23d transform(1., 0., 0., 0., 1., 0.);
+
+	for (size_t p = 0; p < get_Nplanes(_l_object); p++) {
+
+		const Plane& plane = planes[p];
+
+		/*! Pixel x of center subaperture is seen at x - disparity*(u - u_center) in subaperture (u,v).*/
+		transform(0, 2) = plane.disparity * (double(u) - double(center_indices.first));
+		transform(1, 2) = plane.disparity * (double(v) - double(center_indices.second));
+
+		cv::warpAffine(plane.texture, texture, transform, image_size, cv::INTER_LINEAR | cv::WARP_INVERSE_MAP, cv::BORDER_REFLECT);
+		if (p == 0) {
+			cv::warpAffine(plane.support, support, transform, image_size, cv::INTER_LINEAR | cv::WARP_INVERSE_MAP, cv::BORDER_REPLICATE);
+		} else {
+			cv::warpAffine(plane.support, support, transform, image_size, cv::INTER_LINEAR | cv::WARP_INVERSE_MAP, cv::BORDER_CONSTANT, cv::Scalar(0.));
+		}
+
+		/*! Over compositing : nearer plane hides farther ones.*/
+		for (int y = 0; y < image_size.height; y++) {
+			ocv::Timg::value_type* image_row = _image.ptr<ocv::Timg::value_type>(y);
+			const ocv::Timg::value_type* texture_row = texture.ptr<ocv::Timg::value_type>(y);
+			const ocv::Timg1::value_type* support_row = support.ptr<ocv::Timg1::value_type>(y);
+			for (int x = 0; x < image_size.width; x++) {
+				const ocv::Tvalue alpha = support_row[x][0];
+				if (alpha > 0) {
+					image_row[x] = image_row[x] * (1 - alpha) + texture_row[x] * alpha;
+				}
+			}
+		}
+	}
+
+}
+
+void SyntheticLightField::render(SubaperturesData<>& _subapertures, const bool _l_object) const {
+
+	UVindices center_indices = get_center_indices();
+
+	_subapertures.resize_contiguous(parameters.angular_size.first, parameters.angular_size.second, cv::Size(parameters.image_size.first, parameters.image_size.second));
+	_subapertures.set_name("synthetic");
+	_subapertures.set_baseline(Fpair(1., 1.));
+	_subapertures.set_center_coordinates(Fpair(center_indices.first, center_indices.second));
+
+	const unsigned int Nu = parameters.angular_size.first;
+	const unsigned int Nv = parameters.angular_size.second;
+
+	/*! Views are independent.*/
+	cv::parallel_for_(cv::Range(0, int(Nu * Nv)), [&](const cv::Range& _range) {
+		for (int i = _range.start; i < _range.end; i++) {
+			render(i / Nv, i % Nv, _subapertures(i / Nv, i % Nv), _l_object);
+		}
+	});
+
+}
+
+void SyntheticLightField::generate(SubaperturesData<>& _subapertures, ocv::Tmask& _mask, ocv::Timg& _inpainted_image) const {
+
+	render(_subapertures, true);
+
+	UVindices center_indices = get_center_indices();
+	render(center_indices.first, center_indices.second, _inpainted_image, false);
+
+	/*! Object support in center subaperture, slightly dilated to include antialiased edges.*/
+	_mask.create(_inpainted_image.size());
+	_mask = 0;
+	_mask.setTo(cv::Scalar(ocv::mask_value), planes.back().support > 0);
+	cv::dilate(_mask, _mask, cv::Mat(), cv::Point(-1, -1), 1);
+
+}
+
+void SyntheticLightField::generate_ground_truth(SubaperturesData<>& _subapertures) const {
+
+	render(_subapertures, false);
+}
+
+void SyntheticLightField::get_disparity(ocv::Timg1& _disparity, const bool _l_object) const {
+
+	_disparity.create(cv::Size(parameters.image_size.first, parameters.image_size.second));
+	_disparity = (ocv::Tvalue)planes.front().disparity;
+
+	for (size_t p = 1; p < get_Nplanes(_l_object); p++) {
+		_disparity.setTo(cv::Scalar(planes[p].disparity), planes[p].support > (ocv::Tvalue)0.5);
+	}
+
+}
@@ -0,0 +1,78 @@
+/******************************************************************/
+/***            Pierre Allain, INRIA, February 2020				  */
+/***        GNU Affero General Public License version 3			  */
+/******************************************************************/
+
+#pragma once
+
+#include "SubaperturesData.h"
+
+/*! Procedural light field made of textured fronto-parallel planes at known disparities, stacked from background to foreground.
+The nearest plane is a disk : the object to remove. Its support gives the inpainting mask, and rendering without it gives the ground truth.
+Views are rendered in memory (no disk I/O) and in parallel, so that arbitrarily large light fields can be built.*/
+class SyntheticLightField {
+
+public :
+
+	struct Parameters {
+		/*! Angular size of light field (Nu, Nv).*/
+		Upair angular_size = { 9, 9 };
+		/*! Spatial size of subapertures (width, height).*/
+		Upair image_size = { 512, 512 };
+		/*! Disparity range of planes (background, foreground), in pixels between two neighbouring subapertures.*/
+		Fpair disparity_range = { -1., 1. };
+		/*! Number of planes, including background and removed object.*/
+		unsigned int Nplanes = 4;
+		/*! Ratio of image covered by removed object (nearest plane).*/
+		double mask_ratio = 0.05;
+		/*! Standard deviation in pixels of the blur applied to planes noise textures.*/
+		double texture_sigma = 2.;
+		/*! Seed of random generator. Same seed gives same light field.*/
+		unsigned int seed = 0;
+	};
+
+private :
+
+	struct Plane {
+		ocv::Timg texture;
+		/*! Pixels of texture belonging to plane.*/
+		ocv::Timg1 support;
+		double disparity;
+	};
+
+	Parameters parameters;
+
+	/*! Planes sorted from background to foreground. Last one is the removed object.*/
+	std::vector<Plane> planes;
+
+public:
+	SyntheticLightField();
+	SyntheticLightField(const Parameters& _parameters);
+	~SyntheticLightField();
+
+	void set_parameters(const Parameters& _parameters);
+	const Parameters& get_parameters() const;
+
+	UVindices get_center_indices() const;
+
+	/*! Light field with object, mask of object in center subaperture, and center subaperture without object (inpainted ground truth).*/
+	void generate(SubaperturesData<>& _subapertures, ocv::Tmask& _mask, ocv::Timg& _inpainted_image) const;
+	/*! Light field without object : expected result of inpainting propagation.*/
+	void generate_ground_truth(SubaperturesData<>& _subapertures) const;
+	/*! Disparity of center subaperture (same along x and y), with or without object.*/
+	void get_disparity(ocv::Timg1& _disparity, const bool _l_object = true) const;
+
+	/*! Renders subaperture (\p u, \p v), with or without object.*/
+	void render(const unsigned int u, const unsigned int v, ocv::Timg& _image, const bool _l_object = true) const;
+
+private :
+
+	/*! Builds planes textures and supports from parameters.*/
+	void build_planes();
+	void render(SubaperturesData<>& _subapertures, const bool _l_object) const;
+	/*! Number of planes used by rendering.*/
+	size_t get_Nplanes(const bool _l_object) const;
+
+};
+
+#include "SyntheticLightField_Config.h"
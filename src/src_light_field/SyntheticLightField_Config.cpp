@@ -0,0 +1,71 @@
+/******************************************************************/
+/***            Pierre Allain, INRIA, February 2020				  */
+/***        GNU Affero General Public License version 3			  */
+/******************************************************************/
+
+#include "SyntheticLightField_Config.h"
+#include "misc_funcs.h"
+#include "ConfigParameter.h"
+
+const std::map<ConfigParametersSpecializations<SyntheticLightField>::ParametersId, std::string> ConfigParametersSpecializations<SyntheticLightField>::all_parameters = {
+	{ angular_size, "angular_size" },
+{ image_size, "image_size" },
+{ disparity_range, "disparity_range" },
+{ Nplanes, "Nplanes" },
+{ mask_ratio, "mask_ratio" },
+{ texture_sigma, "texture_sigma" },
+{ seed, "seed" }
+};
+
+bool ConfigParametersSpecializations<SyntheticLightField>::set_value(SyntheticLightField::Parameters& _parameters, const std::string& _parameter_name, const std::vector<std::string>& _sub_strings, const std::string& _config_directory) {
+
+	bool l_keep_reading = true;
+
+	if (_parameter_name == all_parameters.at(ParametersId::angular_size)) {
+
+		l_keep_reading = ConfigParameter::read(_parameters.angular_size, _sub_strings, _parameter_name);
+
+	} else if (_parameter_name == all_parameters.at(ParametersId::image_size)) {
+
+		l_keep_reading = ConfigParameter::read(_parameters.image_size, _sub_strings, _parameter_name);
+
+	} else if (_parameter_name == all_parameters.at(ParametersId::disparity_range)) {
+
+		l_keep_reading = ConfigParameter::read(_parameters.disparity_range, _sub_strings, _parameter_name);
+
+	} else if (_parameter_name == all_parameters.at(ParametersId::Nplanes)) {
+
+		l_keep_reading = ConfigParameter::read(_parameters.Nplanes, _sub_strings, _parameter_name);
+
+	} else if (_parameter_name == all_parameters.at(ParametersId::mask_ratio)) {
+
+		l_keep_reading = ConfigParameter::read(_parameters.mask_ratio, _sub_strings, _parameter_name);
+
+	} else if (_parameter_name == all_parameters.at(ParametersId::texture_sigma)) {
+
+		l_keep_reading = ConfigParameter::read(_parameters.texture_sigma, _sub_strings, _parameter_name);
+
+	} else if (_parameter_name == all_parameters.at(ParametersId::seed)) {
+
+		l_keep_reading = ConfigParameter::read(_parameters.seed, _sub_strings, _parameter_name);
+
+	} else {
+		ConfigBase::display_unknown_parameter(_parameter_name);
+		l_keep_reading = false;
+	}
+
+	return l_keep_reading;
+}
+
+void ConfigParametersSpecializations<SyntheticLightField>::deduce_values(SyntheticLightField::Parameters& _parameters) {
+
+}
+
+void ConfigParametersSpecializations<SyntheticLightField>::error_message() {
+
+}
+
+std::vector<std::string> ConfigParametersSpecializations<SyntheticLightField>::check_read_parameters(const std::vector<std::string>& _read_parameters) {
+
+	return ConfigParametersSpecializationsBase::check_read_all_parameters(all_parameters, _read_parameters);
+}
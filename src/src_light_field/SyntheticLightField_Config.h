@@ -0,0 +1,31 @@
+/******************************************************************/
+/***            Pierre Allain, INRIA, February 2020				  */
+/***        GNU Affero General Public License version 3			  */
+/******************************************************************/
+
+#pragma once
+#include "ConfigParameters.h"
+#include "SyntheticLightField.h"
+
+template <>
+struct ConfigParametersSpecializations<SyntheticLightField> {
+
+private:
+	enum ParametersId {
+		angular_size,
+		image_size,
+		disparity_range,
+		Nplanes,
+		mask_ratio,
+		texture_sigma,
+		seed
+	};
+	static const std::map<ParametersId, std::string> all_parameters;
+
+public:
+
+	static bool set_value(SyntheticLightField::Parameters& _parameters, const std::string& _parameter_name, const std::vector<std::string>& _sub_strings, const std::string& _config_directory);
+	static void deduce_values(SyntheticLightField::Parameters& _parameters);
+	static void error_message();
+	static std::vector<std::string> check_read_parameters(const std::vector<std::string>& _read_parameters);
+};
@@ -3,6 +3,8 @@
 /******************************************************************/
 
 #include "Master.h"
+#include "InpaintingCheckpoint.h"
+#include "Profiler.h"
 
 Master::Master() {}
 
@@ -18,3 +20,78 @@ const Master::Parameters& Master::get_parameters() const {
 	return parameters;
 }
 
+
+template <class Timg>
+bool Master::load(const SubaperturesLoader& _loader, SubaperturesData<Timg>& _subapertures) {
+
+	if (_subapertures.load(_loader) && _subapertures.is_coherent()) {
+		return true;
+	} else {
+		std::cout << "Problem loading light field" << std::endl;
+		if (!_subapertures.is_coherent()) {
+			std::cout << "=> light field is incoherent in size" << std::endl;
+		}
+		return false;
+	}
+}
+
+template <class Timg>
+bool Master::process(const SubaperturesData<Timg>& _subapertures, const typename Timg::value_type::value_type _max_value, double& _method_time, double& _write_time) const {
+
+	typedef typename Timg::value_type::value_type Tvalue;
+
+	std::cout << "Dataset name : " << _subapertures.get_name() << std::endl;
+
+	SubaperturesData<Timg> subapertures_result;
+
+	SubaperturesInpainting inpainting;
+	inpainting.set_parameters(parameters.inpainting_parameters);
+
+	{
+		std::cout << "Starting light field processing" << std::endl;
+		Profiler::Scope scope("method");
+
+		/*! Preview is written as soon as available, see SubaperturesInpainting::Parameters::preview_scale.*/
+		inpainting.set_preview_function(std::function<void(const SubaperturesData<Timg>&)>([&](const SubaperturesData<Timg>& _subapertures_preview) {
+			Profiler::Scope scope("write");
+			std::string directory_path = "Preview/";
+			Misc::create_directory(directory_path);
+			_subapertures_preview.imwrite(directory_path, (Tvalue)0, _max_value);
+			std::cout << "Preview written in " << Misc::to_data_path(directory_path) << std::endl;
+		}));
+		inpainting.inpaint(_subapertures, subapertures_result);
+
+		_method_time = scope.elapsed();
+	}
+
+	std::cout << "Method duration : " << Profiler::to_string_duration(_method_time) << std::endl;
+
+	if (subapertures_result.empty()) {
+		_write_time = 0.;
+		return false;
+	}
+
+	{
+		Profiler::Scope scope("write");
+		/*! Create output directory.*/
+		std::string directory_path = "";
+		Misc::create_directory(directory_path);
+		const std::string& checkpoint_path = parameters.inpainting_parameters.inpainting_angular_parameters.checkpoint_path;
+		InpaintingCheckpoint checkpoint;
+		if (!checkpoint_path.empty() && checkpoint.open(checkpoint_path, inpainting.get_checkpoint_key(_subapertures))) {
+			/*! Views written by an interrupted run of this job are skipped. Job is complete once written.*/
+			checkpoint.imwrite(subapertures_result, directory_path, (Tvalue)0, _max_value);
+			checkpoint.clear();
+		} else {
+			subapertures_result.imwrite(directory_path, (Tvalue)0, _max_value);
+		}
+		_write_time = scope.elapsed();
+	}
+
+	return true;
+}
+
+template bool Master::load(const SubaperturesLoader& _loader, SubaperturesData<ocv::Timg>& _subapertures);
+template bool Master::load(const SubaperturesLoader& _loader, SubaperturesData<ocv::Timg8>& _subapertures);
+template bool Master::process(const SubaperturesData<ocv::Timg>& _subapertures, const ocv::Timg::value_type::value_type _max_value, double& _method_time, double& _write_time) const;
+template bool Master::process(const SubaperturesData<ocv::Timg8>& _subapertures, const ocv::Timg8::value_type::value_type _max_value, double& _method_time, double& _write_time) const;
@@ -21,6 +21,12 @@ public :
 		SubaperturesInpainting::Parameters inpainting_parameters;
 		/*! Path where data are written.*/
 		std::string data_path;
+		/*! Name of the JSON profiling report written in #data_path after each run. No report if empty.*/
+		std::string profiling_report_name = "profiling_report.json";
+		/*! Whether execution events are traced and written in #data_path as Chrome trace-event JSON (trace.json).*/
+		bool l_trace = false;
+		/*! Whether light field views are stored in 8 bits. Floating point is then only used for views needed by disparity, and inside mask region of warped views.*/
+		bool l_8bit_storage = false;
 	};
 private :
 
@@ -33,6 +39,16 @@ public:
 	void set_parameters(const Parameters& _parameters);
 	const Parameters& get_parameters() const;
 
+	/*! Loads light field of \p _loader in \p _subapertures. Returns false, with a message, if loading failed or views are incoherent in size.*/
+	template <class Timg>
+	static bool load(const SubaperturesLoader& _loader, SubaperturesData<Timg>& _subapertures);
+	/*! Inpaints \p _subapertures, writing preview as soon as available (see SubaperturesInpainting::Parameters::preview_scale), then writes result in data path,
+	skipping views already written by an interrupted run if checkpointing is enabled. Views of type Timg range from 0 to \p _max_value.
+	Durations in seconds of inpainting and writing are returned in \p _method_time and \p _write_time. Returns false if inpainting gave no result.
+	Instantiated for floating point and 8 bits light fields.*/
+	template <class Timg>
+	bool process(const SubaperturesData<Timg>& _subapertures, const typename Timg::value_type::value_type _max_value, double& _method_time, double& _write_time) const;
+
 };
 
 #include "Master_Config.h"
@@ -14,7 +14,10 @@
 const std::map<ConfigParametersSpecializations<Master>::ParametersId, std::string> ConfigParametersSpecializations<Master>::all_parameters = {
 	{ LF_loader_config_path, "LF_loader_config_path" },
 { method_config_path, "method_config_path" },
-{ data_path, "data_path" }
+{ data_path, "data_path" },
+{ profiling_report_name, "profiling_report_name" },
+{ l_trace, "l_trace" },
+{ l_8bit_storage, "l_8bit_storage" }
 };
 
 bool ConfigParametersSpecializations<Master>::set_value(Master::Parameters& _parameters, const std::string& _parameter_name, const std::vector<std::string>& _sub_strings, const std::string& _config_directory) {
@@ -40,6 +43,18 @@ bool ConfigParametersSpecializations<Master>::set_value(Master::Parameters& _par
 
 		l_keep_reading = ConfigParameter::read(_parameters.data_path, _sub_strings, _parameter_name);
 
+	} else if (_parameter_name == all_parameters.at(ParametersId::profiling_report_name)) {
+
+		l_keep_reading = ConfigParameter::read(_parameters.profiling_report_name, _sub_strings, _parameter_name);
+
+	} else if (_parameter_name == all_parameters.at(ParametersId::l_trace)) {
+
+		l_keep_reading = ConfigParameter::read(_parameters.l_trace, _sub_strings, _parameter_name);
+
+	} else if (_parameter_name == all_parameters.at(ParametersId::l_8bit_storage)) {
+
+		l_keep_reading = ConfigParameter::read(_parameters.l_8bit_storage, _sub_strings, _parameter_name);
+
 	} else {
 		ConfigBase::display_unknown_parameter(_parameter_name);
 		l_keep_reading = false;
@@ -14,6 +14,9 @@ private :
 	enum ParametersId { LF_loader_config_path,
 		method_config_path,
 		data_path,
+		profiling_report_name,
+		l_trace,
+		l_8bit_storage,
 };
 	static const std::map<ParametersId, std::string> all_parameters;
 
@@ -4,3 +4,4 @@
 /*! Additional explicit instantiations needed by the program.*/
 
 template void SubaperturesData<ocv::Timg>::copyPropertiesTo<ocv::Timg1>(SubaperturesData<ocv::Timg1>&) const;
+template void SubaperturesData<ocv::Timg8>::convertTo<ocv::Timg>(SubaperturesData<ocv::Timg>&, const std::vector<UVindices>&) const;
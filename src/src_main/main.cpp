@@ -2,10 +2,10 @@
 /***                Fast Inpainting, INRIA license				  */
 /******************************************************************/
 
-#include <ctime>
-
 #include "Master.h"
 #include "ConfigReader.h"
+#include "Profiler.h"
+#include "Tracing.h"
 
 #include "version.h"
 
@@ -16,55 +16,51 @@ void usage() {
   exit(0);
 }
 
+/*! Loads, inpaints and writes light field with views of type Timg, whose values range from 0 to \p _max_value.*/
+template <class Timg>
+void process(const Master& _master, const SubaperturesLoader& _loader, const typename Timg::value_type::value_type _max_value) {
+
+	SubaperturesData<Timg> subapertures;
+
+	bool l_loaded;
+	{
+		Profiler::Scope scope("load");
+		l_loaded = Master::load(_loader, subapertures);
+	}
+
+	if (l_loaded) {
+		double method_time, write_time;
+		_master.process(subapertures, _max_value, method_time, write_time);
+	}
+
+}
+
 int main(int argc, char** argv) {
 
 	Master master;
 
-	std::string directory_path;
-
 	if (ConfigReader::read(master, argc, argv)) {
 
 		Misc::data_path = master.get_parameters().data_path;
 		std::cout << "Data path is set to : " << Misc::data_path << std::endl;
 
+		Tracing::set_enabled(master.get_parameters().l_trace);
+
 		SubaperturesLoader loader;
 
 		loader.set_parameters(master.get_parameters().LF_loader_parameters);
 
-
-		SubaperturesData<> subapertures;
-
-		if (subapertures.load(loader) && subapertures.is_coherent()) {
-
-
-			std::cout << "Dataset name : " << subapertures.get_name() << std::endl;
-
-			clock_t start;
-			double duration;
-
-			SubaperturesData<> subapertures_result;
-
-
-			std::cout << "Starting light field processing" << std::endl;
-			start = clock();
-
-			SubaperturesInpainting inpainting;
-			inpainting.set_parameters(master.get_parameters().inpainting_parameters);
-			inpainting.inpaint(subapertures, subapertures_result, directory_path);
-
-			/*! Create output directory.*/
-			directory_path = "";
-			Misc::create_directory(directory_path);
-			subapertures_result.imwrite(directory_path, 0., 1.);
-
-			duration = (clock() - start) / (double)CLOCKS_PER_SEC;
-			std::cout << "Method duration : " << (int)duration / 60 << " min, " << (long)duration % 60 << " s, " << (long)(duration*1000.) % 1000 << " ms" << std::endl;
-
+		if (master.get_parameters().l_8bit_storage) {
+			process<ocv::Timg8>(master, loader, 255);
 		} else {
-			std::cout << "Problem loading light field" << std::endl;
-			if (!subapertures.is_coherent()) {
-				std::cout << "=> light field is incoherent in size" << std::endl;
-			}
+			process<ocv::Timg>(master, loader, 1);
+		}
+
+		if (!master.get_parameters().profiling_report_name.empty()) {
+			Profiler::write_report(Misc::to_data_path(master.get_parameters().profiling_report_name));
+		}
+		if (master.get_parameters().l_trace) {
+			Tracing::write(Misc::to_data_path("trace.json"));
 		}
 
 		std::cout << "End of program" << std::endl;
@@ -231,7 +231,9 @@ bool ocv::is_equal(const cv::Mat& _image1, const cv::Mat& _image2) {
 cv::Mat ocv::reduce_channels(const cv::Mat& _input, const int _rtype) {
 
 	unsigned int rows = _input.rows;
-	cv::Mat output = _input.reshape(1, rows*_input.cols);
+	/*! Reshaping needs continuous data (input can be a region of interest).*/
+	cv::Mat output = _input.isContinuous() ? _input : _input.clone();
+	output = output.reshape(1, rows*_input.cols);
 	cv::reduce(output, output, 1, _rtype);
 	output = output.reshape(1, rows);
 	return output;
@@ -44,6 +44,8 @@ namespace ocv {
 	typedef cv::Mat_< cv::Vec<Tvalue, 2> > Timg2;
 	typedef cv::Mat_< cv::Vec<Tvalue, 3> > Timg3;
 	typedef cv::Mat_< cv::Vec<Tvalue, 4> > Timg4;
+	/*! Type of images stored with 8 bits per channel, for memory saving.*/
+	typedef cv::Mat_< cv::Vec<uchar, 3> > Timg8;
 
 	typedef cv::Vec<int, 1> Tvec1i;//CV_32SC1
 
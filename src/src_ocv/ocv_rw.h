@@ -8,6 +8,7 @@
 #include <opencv2/core.hpp>
 #include <opencv2/imgproc.hpp>
 #include "ocv_minmax.h"/* For Range.*/
+#include "Tracing.h"
 
 namespace ocv {
 
@@ -32,6 +33,11 @@ namespace ocv {
 	/*! Read images. Uses buffer.*/
 	template <class Tval, int Dim>
 	void imread(const std::string& _read_name, cv::Mat_< cv::Vec<Tval, Dim> >& _image, cv::Mat_< cv::Vec<uchar, 3> >& _read_image_buffer);
+	/*! Read images rescaled by (\p _scale_x, \p _scale_y), in addition to size_coef. When downscaling, uses reduced decoding (1/2, 1/4, 1/8) as much as possible,
+	and resizes remaining scale in 8 bits before conversion to Tval.
+	With reduced decoding, rescaled size is deduced from decoded size, and can differ by one pixel from rescaling of full image.*/
+	template <class Tval, int Dim>
+	void imread(const std::string& _read_name, cv::Mat_< cv::Vec<Tval, Dim> >& _image, const double _scale_x, const double _scale_y);
 
 }
 
@@ -65,6 +71,8 @@ void ocv::imwrite(const std::string& _write_name, const cv::Mat_< cv::Vec<Tval,
 template <class Tval, int Dim>
 void ocv::imwrite(const std::string& _write_name, const cv::Mat_< cv::Vec<Tval, Dim> >& _image, const ocv::Range<Tval>& _range_input, cv::Mat_< cv::Vec<uchar, Dim> >& _write_image_buffer, const std::string _ext) {
 
+	Tracing::Scope scope("imwrite");
+
 #ifdef ENABLE_LIB_OPENEXR
 		if (_ext == ".exr") {
 			OpenEXR::exrwrite(_image, _write_name + _ext);
@@ -113,4 +121,50 @@ void ocv::imread(const std::string& _read_name, cv::Mat_< cv::Vec<Tval, Dim> >&
 		std::cout << "WARNING : " << _read_name << " is empty" << std::endl;
 	}
 
+}
+
+template <class Tval, int Dim>
+void ocv::imread(const std::string& _read_name, cv::Mat_< cv::Vec<Tval, Dim> >& _image, const double _scale_x, const double _scale_y) {
+
+	double scale_x = _scale_x;
+	double scale_y = _scale_y;
+	if (size_coef.width != 0 && size_coef.height != 0) {
+		scale_x *= size_coef.width;
+		scale_y *= size_coef.height;
+	}
+
+	/*! Largest decoding reduction not exceeding downscaling in both directions.*/
+	int reduction = 1;
+	int read_flag = cv::IMREAD_COLOR;
+	const double scale_max = std::max(scale_x, scale_y);
+	if (scale_max * 8. <= 1.) {
+		reduction = 8;
+		read_flag = cv::IMREAD_REDUCED_COLOR_8;
+	} else if (scale_max * 4. <= 1.) {
+		reduction = 4;
+		read_flag = cv::IMREAD_REDUCED_COLOR_4;
+	} else if (scale_max * 2. <= 1.) {
+		reduction = 2;
+		read_flag = cv::IMREAD_REDUCED_COLOR_2;
+	}
+
+	cv::Mat_< cv::Vec<uchar, 3> > read_image_buffer = cv::imread(_read_name, read_flag);
+
+	if (!read_image_buffer.empty()) {
+
+		cv::Size rescaled_size;
+		rescaled_size.width = std::max(cvRound(read_image_buffer.cols * reduction * scale_x), 1);
+		rescaled_size.height = std::max(cvRound(read_image_buffer.rows * reduction * scale_y), 1);
+
+		if (rescaled_size != read_image_buffer.size()) {
+			cv::resize(read_image_buffer, read_image_buffer, rescaled_size);
+		}
+
+		ocv::convertTo(read_image_buffer, _image, true);
+
+	} else {
+		_image.release();
+		std::cout << "WARNING : " << _read_name << " is empty" << std::endl;
+	}
+
 }
\ No newline at end of file
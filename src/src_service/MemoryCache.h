@@ -0,0 +1,109 @@
+/******************************************************************/
+/***                Fast Inpainting, INRIA license				  */
+/******************************************************************/
+
+#pragma once
+
+#include <list>
+#include <memory>
+#include <string>
+
+/*! Least recently used cache of objects of any type, bounded by a memory budget. Each object is stored with its size in bytes.
+Objects are shared : an object evicted from cache stays alive as long as it is used.*/
+class MemoryCache {
+
+	struct Entry {
+		std::string key;
+		std::shared_ptr<void> data;
+		size_t size;
+	};
+
+	/*! Most recently used first.*/
+	std::list<Entry> entries;
+
+	size_t budget;
+	size_t used;
+
+public :
+
+	MemoryCache(const size_t _budget = 0) : budget(_budget), used(0) {}
+
+	void set_budget(const size_t _budget) {
+
+		budget = _budget;
+		evict(0);
+	}
+
+	size_t get_budget() const {
+
+		return budget;
+	}
+
+	/*! Sum of sizes of cached objects, in bytes.*/
+	size_t get_used() const {
+
+		return used;
+	}
+
+	size_t size() const {
+
+		return entries.size();
+	}
+
+	/*! Object of \p _key, null if not cached. Becomes the most recently used one.
+	Type T must be the one used by put for this key.*/
+	template <class T>
+	std::shared_ptr<T> get(const std::string& _key) {
+
+		for (std::list<Entry>::iterator it = entries.begin(); it != entries.end(); ++it) {
+			if (it->key == _key) {
+				entries.splice(entries.begin(), entries, it);
+				return std::static_pointer_cast<T>(entries.front().data);
+			}
+		}
+		return std::shared_ptr<T>();
+	}
+
+	/*! Caches \p _data of \p _size bytes as most recently used object, evicting least recently used ones to stay within budget.
+	An object larger than budget is not cached.*/
+	template <class T>
+	void put(const std::string& _key, const std::shared_ptr<T>& _data, const size_t _size) {
+
+		remove(_key);
+
+		if (_size <= budget) {
+			evict(_size);
+			entries.push_front(Entry{ _key, _data, _size });
+			used += _size;
+		}
+	}
+
+	void remove(const std::string& _key) {
+
+		for (std::list<Entry>::iterator it = entries.begin(); it != entries.end(); ++it) {
+			if (it->key == _key) {
+				used -= it->size;
+				entries.erase(it);
+				return;
+			}
+		}
+	}
+
+	void clear() {
+
+		entries.clear();
+		used = 0;
+	}
+
+private :
+
+	/*! Evicts least recently used objects until \p _size bytes fit in budget.*/
+	void evict(const size_t _size) {
+
+		while (!entries.empty() && used + _size > budget) {
+			used -= entries.back().size;
+			entries.pop_back();
+		}
+	}
+
+};
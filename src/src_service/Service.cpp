@@ -0,0 +1,514 @@
+/******************************************************************/
+/***                Fast Inpainting, INRIA license				  */
+/******************************************************************/
+
+#include "Service.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include "ConfigReader.h"
+#include "InpaintingCheckpoint.h"
+#include "Profiler.h"
+
+#ifndef _WIN32
+#include <csignal>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+	typedef std::chrono::steady_clock Clock;
+
+	double elapsed(const Clock::time_point& _start) {
+
+		return std::chrono::duration<double>(Clock::now() - _start).count();
+	}
+
+#if !defined(_WIN32) && defined(MSG_NOSIGNAL)
+	const int send_flags = MSG_NOSIGNAL;
+#else
+	const int send_flags = 0;
+#endif
+
+	/*! Appends to \p _string the character of JSON escape sequence at \p _i of \p _string_json, just after the backslash. Returns index following sequence.*/
+	size_t read_escape(const std::string& _string_json, size_t _i, std::string& _string) {
+
+		const char c = _string_json[_i];
+		switch (c) {
+		case 'b': _string += '\b'; break;
+		case 'f': _string += '\f'; break;
+		case 'n': _string += '\n'; break;
+		case 'r': _string += '\r'; break;
+		case 't': _string += '\t'; break;
+		case 'u': {
+			const std::string digits = _i + 4 < _string_json.size() ? _string_json.substr(_i + 1, 4) : "";
+			if (digits.empty() || !std::all_of(digits.begin(), digits.end(), [](char _c) { return std::isxdigit((unsigned char)_c) != 0; })) {
+				/*! Invalid sequence kept as written.*/
+				_string += c;
+				break;
+			}
+			const unsigned long code = std::stoul(digits, nullptr, 16);
+			_i += 4;
+			/*! Code point encoded in UTF-8. Surrogate pairs are not combined.*/
+			if (code < 0x80) {
+				_string += char(code);
+			} else if (code < 0x800) {
+				_string += char(0xC0 | (code >> 6));
+				_string += char(0x80 | (code & 0x3F));
+			} else {
+				_string += char(0xE0 | (code >> 12));
+				_string += char(0x80 | ((code >> 6) & 0x3F));
+				_string += char(0x80 | (code & 0x3F));
+			}
+			break;
+		}
+		/*! Quote, backslash, slash.*/
+		default: _string += c; break;
+		}
+		return _i + 1;
+	}
+
+	std::string answer_error(const std::string& _message) {
+
+		return "{ \"success\" : false, \"error\" : \"" + Misc::json_escape(_message) + "\" }";
+	}
+
+}
+
+Service::Service() : l_running(false) {}
+
+Service::~Service() {}
+
+void Service::set_parameters(const Parameters& _parameters) {
+
+	parameters = _parameters;
+	cache.set_budget(size_t(parameters.memory_budget) << 20);
+}
+
+const Service::Parameters& Service::get_parameters() const {
+
+	return parameters;
+}
+
+std::map<std::string, std::string> Service::parse_request(const std::string& _request) {
+
+	std::map<std::string, std::string> members;
+
+	size_t i = _request.find('{');
+	if (i == std::string::npos) {
+		return members;
+	}
+	i++;
+
+	auto skip_spaces = [&]() {
+		while (i < _request.size() && std::isspace((unsigned char)_request[i])) {
+			i++;
+		}
+	};
+
+	auto read_string = [&]() {
+		std::string string;
+		/*! Opening quote.*/
+		i++;
+		while (i < _request.size() && _request[i] != '"') {
+			if (_request[i] == '\\' && i + 1 < _request.size()) {
+				i++;
+				i = read_escape(_request, i, string);
+			} else {
+				string += _request[i];
+				i++;
+			}
+		}
+		/*! Closing quote.*/
+		i++;
+		return string;
+	};
+
+	while (i < _request.size()) {
+
+		skip_spaces();
+		if (i >= _request.size() || _request[i] != '"') {
+			break;
+		}
+		std::string key = read_string();
+
+		skip_spaces();
+		if (i >= _request.size() || _request[i] != ':') {
+			break;
+		}
+		i++;
+		skip_spaces();
+
+		std::string value;
+		if (i < _request.size() && _request[i] == '"') {
+			value = read_string();
+		} else {
+			/*! Numbers, booleans and arrays of numbers are kept as written.*/
+			const char end = (i < _request.size() && _request[i] == '[') ? ']' : '\0';
+			while (i < _request.size() && (end ? _request[i] != end : (_request[i] != ',' && _request[i] != '}'))) {
+				value += _request[i];
+				i++;
+			}
+			if (end && i < _request.size()) {
+				value += end;
+				i++;
+			}
+			while (!value.empty() && std::isspace((unsigned char)value.back())) {
+				value.pop_back();
+			}
+		}
+		members[key] = value;
+
+		skip_spaces();
+		if (i < _request.size() && _request[i] == ',') {
+			i++;
+		} else {
+			break;
+		}
+	}
+
+	return members;
+}
+
+std::string Service::get_light_field_key(const Master::Parameters& _job) {
+
+	SubaperturesLoader loader(_job.LF_loader_parameters);
+	return loader.get_load_key() + " | " + Misc::to_string(_job.l_8bit_storage);
+}
+
+std::string Service::get_disparities_key(const Master::Parameters& _job) {
+
+	const DisparityFastGradient::Parameters& disparity_parameters = _job.inpainting_parameters.inpainting_angular_parameters.disparity_fast_gradient_parameters;
+	std::ostringstream key;
+	key << "disparities | " << get_light_field_key(_job) << " | ";
+	key << _job.inpainting_parameters.subaperture_position.first << " " << _job.inpainting_parameters.subaperture_position.second << " | ";
+	key << disparity_parameters.disparity_bound[0] << " " << disparity_parameters.l_denoise_disparity << " " << disparity_parameters.lambda_denoise << " " << disparity_parameters.Niterations_denoise << " " << disparity_parameters.tolerance_denoise;
+	return key.str();
+}
+
+std::string Service::get_superpixels_key(const Master::Parameters& _job, const ocv::Timg& _inpainted_subaperture, const ocv::Tmask& _mask) {
+
+	const SubaperturesInpainting::Parameters& inpainting_parameters = _job.inpainting_parameters;
+	const InpaintingAngular::Parameters& angular_parameters = inpainting_parameters.inpainting_angular_parameters;
+	const SuperPixelSegmentation::Parameters& sps_parameters = angular_parameters.sps_parameters;
+
+	std::ostringstream key;
+	key << "superpixels | " << inpainting_parameters.inpainted_subaperture_path << " | " << inpainting_parameters.mask_path << " | ";
+	key << sps_parameters.Nsuperpixels << " " << sps_parameters.Nsuperpixels_per_pixel << " " << sps_parameters.ruler_coef << " " << sps_parameters.Niterations << " " << sps_parameters.conversion_type << " " << sps_parameters.sigma_blur.width << " " << sps_parameters.sigma_blur.height;
+	key << " " << angular_parameters.sps_merger_parameters.Nknown_pixels_min << " " << angular_parameters.sps_merger_parameters.merge_coef;
+	key << " " << angular_parameters.sps_interpolation_parameters.Nweight_pixels << " " << angular_parameters.sps_interpolation_parameters.distance_coef << " " << angular_parameters.sps_interpolation_parameters.sigma_coef;
+	return InpaintingCheckpoint::get_key({ _inpainted_subaperture, _mask }, key.str());
+}
+
+template <class Timg>
+size_t Service::get_memory_size(const SubaperturesData<Timg>& _subapertures) {
+
+	size_t size = 0;
+	for (unsigned int u = 0; u < _subapertures.get_Nu(); u++) {
+		for (unsigned int v = 0; v < _subapertures.get_Nv(); v++) {
+			size += _subapertures(u, v).total() * _subapertures(u, v).elemSize();
+		}
+	}
+	return size;
+}
+
+size_t Service::get_memory_size(const ocv::VecImg& _disparities) {
+
+	return _disparities.first.total() * _disparities.first.elemSize() + _disparities.second.total() * _disparities.second.elemSize();
+}
+
+size_t Service::get_memory_size(const InpaintingAngular::SPS& _sps, const unsigned int _Nweight_pixels, const size_t _Nmasked) {
+
+	/*! Original and recolored images, labels, and weights pointers.*/
+	const size_t Npixels = _sps.sps.size().area();
+	size_t size = Npixels * (2 * sizeof(ocv::Tvec) + sizeof(int) + sizeof(ocv::Timg_ptr_type));
+	size += _Nmasked * _Nweight_pixels * sizeof(std::pair<double, int>);
+	return size;
+}
+
+template <class Timg>
+void Service::run_job(const Master::Parameters& _job, Result& _result, const typename Timg::value_type::value_type _max_value) {
+
+	typedef typename Timg::value_type::value_type Tvalue;
+
+	Clock::time_point start = Clock::now();
+
+	const std::string light_field_key = get_light_field_key(_job);
+	std::shared_ptr< SubaperturesData<Timg> > subapertures = cache.get< SubaperturesData<Timg> >(light_field_key);
+	_result.l_cached_light_field = (bool)subapertures;
+
+	if (!subapertures) {
+
+		SubaperturesLoader loader;
+		loader.set_parameters(_job.LF_loader_parameters);
+
+		subapertures = std::make_shared< SubaperturesData<Timg> >();
+		if (!subapertures->load(loader) || !subapertures->is_coherent()) {
+			std::cout << "Problem loading light field" << std::endl;
+			return;
+		}
+		cache.put(light_field_key, subapertures, get_memory_size(*subapertures));
+	}
+	_result.load_time = elapsed(start);
+
+	start = Clock::now();
+
+	SubaperturesInpainting inpainting;
+	inpainting.set_parameters(_job.inpainting_parameters);
+
+	/*! Images are read once : superpixels key hashes the very images that are inpainted.*/
+	ocv::Timg inpainted_image;
+	ocv::Tmask mask;
+	inpainting.read_images(inpainted_image, mask);
+
+	const std::string disparities_key = get_disparities_key(_job);
+	const std::string superpixels_key = get_superpixels_key(_job, inpainted_image, mask);
+
+	InpaintingAngular::EditCache edit_cache;
+	edit_cache.disparities = cache.get<ocv::VecImg>(disparities_key);
+	edit_cache.sps = cache.get<InpaintingAngular::SPS>(superpixels_key);
+	_result.l_cached_disparities = (bool)edit_cache.disparities;
+	_result.l_cached_superpixels = (bool)edit_cache.sps;
+
+	SubaperturesData<Timg> subapertures_result;
+	inpainting.inpaint(*subapertures, inpainted_image, mask, edit_cache, subapertures_result);
+
+	if (!_result.l_cached_disparities && edit_cache.disparities) {
+		cache.put(disparities_key, edit_cache.disparities, get_memory_size(*edit_cache.disparities));
+	}
+	if (!_result.l_cached_superpixels && edit_cache.sps) {
+		const size_t Nmasked = mask.empty() ? 0 : cv::countNonZero(mask == ocv::mask_value);
+		cache.put(superpixels_key, edit_cache.sps, get_memory_size(*edit_cache.sps, _job.inpainting_parameters.inpainting_angular_parameters.sps_interpolation_parameters.Nweight_pixels, Nmasked));
+	}
+	_result.method_time = elapsed(start);
+
+	if (subapertures_result.empty()) {
+		return;
+	}
+
+	start = Clock::now();
+	subapertures_result.imwrite("", (Tvalue)0, _max_value);
+	_result.write_time = elapsed(start);
+
+	_result.l_success = true;
+}
+
+std::string Service::process(const std::string& _request) {
+
+	/*! A failing request must not stop the service.*/
+	try {
+		return process_request(_request);
+	} catch (const std::exception& _exception) {
+		std::cout << "Service : request failed : " << _exception.what() << std::endl;
+		return answer_error(std::string("request failed : ") + _exception.what());
+	} catch (...) {
+		std::cout << "Service : request failed" << std::endl;
+		return answer_error("request failed");
+	}
+}
+
+std::string Service::process_request(const std::string& _request) {
+
+	std::map<std::string, std::string> members = parse_request(_request);
+
+	if (members.count("command")) {
+
+		if (members["command"] == "shutdown") {
+			l_running = false;
+			return "{ \"success\" : true }";
+		} else if (members["command"] == "status") {
+			std::ostringstream answer;
+			answer << "{ \"success\" : true, \"Ncached\" : " << cache.size() << ", \"cache_used_MB\" : " << double(cache.get_used()) / double(1 << 20) << ", \"cache_budget_MB\" : " << parameters.memory_budget << " }";
+			return answer.str();
+		} else {
+			return answer_error("unknown command " + members["command"]);
+		}
+	}
+
+	if (!members.count("config")) {
+		return answer_error("missing config");
+	}
+
+	Master::Parameters job;
+	if (!ConfigReader::read<Master>(job, members["config"])) {
+		return answer_error("failed to read config " + members["config"]);
+	}
+
+	if (members.count("data_path")) {
+		job.data_path = members["data_path"];
+	}
+	if (members.count("mask_path")) {
+		job.inpainting_parameters.mask_path = members["mask_path"];
+	}
+	if (members.count("inpainted_subaperture_path")) {
+		job.inpainting_parameters.inpainted_subaperture_path = members["inpainted_subaperture_path"];
+	}
+	if (members.count("subaperture_position")) {
+		std::vector<unsigned int> position = Misc::get_numbers(members["subaperture_position"]);
+		if (position.size() != 2) {
+			return answer_error("subaperture_position must be [u, v]");
+		}
+		job.inpainting_parameters.subaperture_position = UVindices(position[0], position[1]);
+	}
+
+	/*! Results of job are written in its data path.*/
+	Misc::data_path = job.data_path.empty() ? parameters.data_path : job.data_path;
+	Misc::create_directory("");
+
+	Clock::time_point start = Clock::now();
+
+	Result result;
+	if (job.l_8bit_storage) {
+		run_job<ocv::Timg8>(job, result, 255);
+	} else {
+		run_job<ocv::Timg>(job, result, 1);
+	}
+	result.total_time = elapsed(start);
+
+	std::cout << "Request duration : " << Profiler::to_string_duration(result.total_time) << (result.l_cached_light_field ? " (cached light field)" : "") << std::endl;
+
+	std::ostringstream answer;
+	answer << std::setprecision(6) << std::fixed;
+	answer << "{ \"success\" : " << (result.l_success ? "true" : "false");
+	answer << ", \"cached_light_field\" : " << (result.l_cached_light_field ? "true" : "false");
+	answer << ", \"cached_disparities\" : " << (result.l_cached_disparities ? "true" : "false");
+	answer << ", \"cached_superpixels\" : " << (result.l_cached_superpixels ? "true" : "false");
+	answer << ", \"load_s\" : " << result.load_time;
+	answer << ", \"method_s\" : " << result.method_time;
+	answer << ", \"write_s\" : " << result.write_time;
+	answer << ", \"total_s\" : " << result.total_time << " }";
+	return answer.str();
+}
+
+std::string Service::get_default_socket_path() {
+
+#ifdef _WIN32
+	return "";
+#else
+	/*! Runtime directory of user is private to user.*/
+	const char* runtime_directory = std::getenv("XDG_RUNTIME_DIR");
+	if (runtime_directory && runtime_directory[0] != '\0') {
+		return Misc::concat_path_and_filename(runtime_directory, "FastLFInpainting.sock");
+	} else {
+		return "/tmp/FastLFInpainting-" + Misc::to_string(getuid()) + ".sock";
+	}
+#endif
+}
+
+bool Service::run() {
+
+#ifdef _WIN32
+	std::cout << "Service : Unix domain sockets are not supported on this platform" << std::endl;
+	return false;
+#else
+
+	if (parameters.Nthreads > 0) {
+		cv::setNumThreads(parameters.Nthreads);
+	}
+	/*! Records of a long running process would grow without bound.*/
+	Profiler::set_enabled(false);
+	/*! Writing to a client that disconnected must not stop the service.*/
+	signal(SIGPIPE, SIG_IGN);
+
+	const std::string socket_path = parameters.socket_path.empty() ? get_default_socket_path() : parameters.socket_path;
+
+	sockaddr_un address;
+	if (socket_path.empty() || socket_path.size() >= sizeof(address.sun_path)) {
+		std::cout << "Service : invalid socket path " << socket_path << std::endl;
+		return false;
+	}
+
+	int server = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (server < 0) {
+		std::cout << "Service : failed to create socket" << std::endl;
+		return false;
+	}
+
+	std::memset(&address, 0, sizeof(address));
+	address.sun_family = AF_UNIX;
+	std::strncpy(address.sun_path, socket_path.c_str(), sizeof(address.sun_path) - 1);
+	/*! Socket left by a previous service is removed, but never another file.*/
+	struct stat status;
+	if (lstat(socket_path.c_str(), &status) == 0) {
+		if (S_ISSOCK(status.st_mode)) {
+			unlink(socket_path.c_str());
+		} else {
+			std::cout << "Service : " << socket_path << " exists and is not a socket" << std::endl;
+			close(server);
+			return false;
+		}
+	}
+
+	/*! Requests read configs and write results with privileges of service : only its user may connect.
+	Socket is created without group and others permissions, so that it is never open to them, even before chmod.*/
+	const mode_t umask_previous = umask(S_IRWXG | S_IRWXO);
+	const bool l_bound = bind(server, (sockaddr*)&address, sizeof(address)) == 0;
+	umask(umask_previous);
+
+	if (!l_bound || chmod(socket_path.c_str(), S_IRUSR | S_IWUSR) < 0 || listen(server, 8) < 0) {
+		std::cout << "Service : failed to listen on " << socket_path << std::endl;
+		close(server);
+		if (l_bound) {
+			unlink(socket_path.c_str());
+		}
+		return false;
+	}
+
+	std::cout << "Listening on " << socket_path << std::endl;
+
+	l_running = true;
+	while (l_running) {
+
+		int client = accept(server, nullptr, nullptr);
+		if (client < 0) {
+			continue;
+		}
+
+		if (parameters.receive_timeout > 0) {
+			timeval timeout;
+			timeout.tv_sec = parameters.receive_timeout;
+			timeout.tv_usec = 0;
+			setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+		}
+
+		/*! A request ends with a line feed or when client stops writing.*/
+		std::string request;
+		char buffer[4096];
+		ssize_t Nread;
+		while (request.find('\n') == std::string::npos && (Nread = read(client, buffer, sizeof(buffer))) > 0) {
+			request.append(buffer, Nread);
+		}
+
+		if (request.empty()) {
+			/*! Client disconnected or timed out before sending anything.*/
+			close(client);
+			continue;
+		}
+
+		std::string answer = process(request) + "\n";
+		size_t Nwritten = 0;
+		while (Nwritten < answer.size()) {
+			ssize_t N = send(client, answer.data() + Nwritten, answer.size() - Nwritten, send_flags);
+			if (N <= 0) {
+				break;
+			}
+			Nwritten += N;
+		}
+
+		close(client);
+	}
+
+	close(server);
+	unlink(socket_path.c_str());
+	cache.clear();
+
+	return true;
+#endif
+}
@@ -0,0 +1,99 @@
+/******************************************************************/
+/***                Fast Inpainting, INRIA license				  */
+/******************************************************************/
+
+#pragma once
+
+#include <map>
+#include "Master.h"
+#include "MemoryCache.h"
+
+/*! Long running inpainting service. Listens on a Unix domain socket and processes one JSON request per connection, answered by one JSON line.
+Loaded light fields, disparities of light fields at inpainted positions and superpixel interpolation weights of (inpainted view, mask) pairs are kept
+in a least recently used cache bounded by a memory budget : a request on an already loaded light field skips parsing, decoding, disparity and segmentation.
+
+Requests :
+- { "config" : "<master config file>" } : inpainting job described by a master config file. Optional members override it :
+"data_path", "mask_path", "inpainted_subaperture_path", "subaperture_position" : [u, v].
+- { "command" : "status" } : cache state.
+- { "command" : "shutdown" } : stops service.
+Strings of requests may hold JSON escape sequences.
+Cached data are identified by paths and parameters, and by values of inpainted view and mask : light fields are assumed unchanged on disk.*/
+class Service {
+
+public :
+
+	struct Parameters {
+		/*! Path of Unix domain socket, only accessible by user of service. get_default_socket_path if empty.*/
+		std::string socket_path;
+		/*! Memory budget of cache, in MB.*/
+		unsigned int memory_budget = 4096;
+		/*! Number of threads used by jobs. OpenCV default if 0.*/
+		unsigned int Nthreads = 0;
+		/*! Time in seconds after which a client that sends nothing is disconnected, so that it can't block other clients. No timeout if 0.*/
+		unsigned int receive_timeout = 10;
+		/*! Path where data are written if not defined by request master config.*/
+		std::string data_path;
+	};
+
+	/*! Outcome of a job, timings in seconds.*/
+	struct Result {
+		bool l_success = false;
+		bool l_cached_light_field = false;
+		bool l_cached_disparities = false;
+		bool l_cached_superpixels = false;
+		double load_time = 0.;
+		double method_time = 0.;
+		double write_time = 0.;
+		double total_time = 0.;
+	};
+
+private :
+
+	Parameters parameters;
+
+	MemoryCache cache;
+
+	bool l_running;
+
+public:
+	Service();
+	~Service();
+
+	void set_parameters(const Parameters& _parameters);
+	const Parameters& get_parameters() const;
+
+	/*! FastLFInpainting.sock in user runtime directory ($XDG_RUNTIME_DIR), or /tmp/FastLFInpainting-<uid>.sock if not defined.*/
+	static std::string get_default_socket_path();
+
+	/*! Listens and processes requests until a shutdown request. Returns false if socket could not be opened.*/
+	bool run();
+	/*! Processes a JSON request. Returns JSON answer, an error answer if processing failed.*/
+	std::string process(const std::string& _request);
+
+private :
+
+	/*! Same as process, exceptions being raised instead of answered.*/
+	std::string process_request(const std::string& _request);
+
+	/*! Loads, inpaints and writes light field of \p _job, with views of type Timg whose values range from 0 to \p _max_value.*/
+	template <class Timg>
+	void run_job(const Master::Parameters& _job, Result& _result, const typename Timg::value_type::value_type _max_value);
+
+	/*! Members of a flat JSON object : strings are unquoted, other values are kept as written.*/
+	static std::map<std::string, std::string> parse_request(const std::string& _request);
+
+	static std::string get_light_field_key(const Master::Parameters& _job);
+	static std::string get_disparities_key(const Master::Parameters& _job);
+	/*! Superpixels depend on values of inpainted subaperture \p _inpainted_subaperture and mask \p _mask, hashed : an edited mask is detected whenever it is written.*/
+	static std::string get_superpixels_key(const Master::Parameters& _job, const ocv::Timg& _inpainted_subaperture, const ocv::Tmask& _mask);
+
+	/*! Sizes of cached data, in bytes.*/
+	template <class Timg>
+	static size_t get_memory_size(const SubaperturesData<Timg>& _subapertures);
+	static size_t get_memory_size(const ocv::VecImg& _disparities);
+	/*! Estimate for superpixels : images of segmentation, and \p _Nweight_pixels weights for each of the \p _Nmasked pixels of mask.*/
+	static size_t get_memory_size(const InpaintingAngular::SPS& _sps, const unsigned int _Nweight_pixels, const size_t _Nmasked);
+};
+
+#include "Service_Config.h"
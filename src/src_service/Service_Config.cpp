@@ -0,0 +1,61 @@
+/******************************************************************/
+/***                Fast Inpainting, INRIA license				  */
+/******************************************************************/
+
+#include "Service_Config.h"
+#include "misc_funcs.h"
+#include "ConfigParameter.h"
+#include "ConfigReader.h"
+
+const std::map<ConfigParametersSpecializations<Service>::ParametersId, std::string> ConfigParametersSpecializations<Service>::all_parameters = {
+	{ socket_path, "socket_path" },
+{ memory_budget, "memory_budget" },
+{ Nthreads, "Nthreads" },
+{ receive_timeout, "receive_timeout" },
+{ data_path, "data_path" }
+};
+
+bool ConfigParametersSpecializations<Service>::set_value(Service::Parameters& _parameters, const std::string& _parameter_name, const std::vector<std::string>& _sub_strings, const std::string& _config_directory) {
+
+	bool l_keep_reading = true;
+
+	if (_parameter_name == all_parameters.at(ParametersId::socket_path)) {
+
+		l_keep_reading = ConfigParameter::read(_parameters.socket_path, _sub_strings, _parameter_name);
+
+	} else if (_parameter_name == all_parameters.at(ParametersId::memory_budget)) {
+
+		l_keep_reading = ConfigParameter::read(_parameters.memory_budget, _sub_strings, _parameter_name);
+
+	} else if (_parameter_name == all_parameters.at(ParametersId::Nthreads)) {
+
+		l_keep_reading = ConfigParameter::read(_parameters.Nthreads, _sub_strings, _parameter_name);
+
+	} else if (_parameter_name == all_parameters.at(ParametersId::receive_timeout)) {
+
+		l_keep_reading = ConfigParameter::read(_parameters.receive_timeout, _sub_strings, _parameter_name);
+
+	} else if (_parameter_name == all_parameters.at(ParametersId::data_path)) {
+
+		l_keep_reading = ConfigParameter::read(_parameters.data_path, _sub_strings, _parameter_name);
+
+	} else {
+		ConfigBase::display_unknown_parameter(_parameter_name);
+		l_keep_reading = false;
+	}
+
+	return l_keep_reading;
+}
+
+void ConfigParametersSpecializations<Service>::deduce_values(Service::Parameters& _parameters) {
+
+}
+
+void ConfigParametersSpecializations<Service>::error_message() {
+
+}
+
+std::vector<std::string> ConfigParametersSpecializations<Service>::check_read_parameters(const std::vector<std::string>& _read_parameters) {
+
+	return ConfigParametersSpecializationsBase::check_read_all_parameters(all_parameters, _read_parameters);
+}
@@ -0,0 +1,29 @@
+/******************************************************************/
+/***                Fast Inpainting, INRIA license				  */
+/******************************************************************/
+
+#pragma once
+#include "ConfigParameters.h"
+#include "Service.h"
+
+
+template <>
+struct ConfigParametersSpecializations<Service> {
+
+private :
+	enum ParametersId { socket_path,
+		memory_budget,
+		Nthreads,
+		receive_timeout,
+		data_path,
+};
+	static const std::map<ParametersId, std::string> all_parameters;
+
+public:
+
+	static bool set_value(Service::Parameters& _parameters, const std::string& _parameter_name, const std::vector<std::string>& _sub_strings, const std::string& _config_directory);
+	static void deduce_values(Service::Parameters& _parameters);
+	static void error_message();
+	static std::vector<std::string> check_read_parameters(const std::vector<std::string>& _read_parameters);
+
+};
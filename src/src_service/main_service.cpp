@@ -0,0 +1,36 @@
+/******************************************************************/
+/***                Fast Inpainting, INRIA license				  */
+/******************************************************************/
+
+#include "Service.h"
+#include "ConfigReader.h"
+
+#include "version.h"
+
+void usage() {
+  std::cout << "FastLFInpaintingService " << FI_VERSION_MAJOR<< "." << FI_VERSION_MINOR << "." << FI_VERSION_PATCH << " : " << std::endl;
+  std::cout << "    Usage : ./FastLFInpaintingService <config-file>" << std::endl;
+  std::cout << "    <config-file> full path to the configuration file providing socket path and cache budget." << std::endl;
+  std::cout << "    Requests are JSON objects sent on the socket, one per connection : { \"config\" : \"<master config file>\" }, { \"command\" : \"status\" } or { \"command\" : \"shutdown\" }." << std::endl;
+  exit(0);
+}
+
+int main(int argc, char** argv) {
+
+	Service service;
+
+	if (ConfigReader::read(service, argc, argv)) {
+
+		Misc::data_path = service.get_parameters().data_path;
+		std::cout << "Data path is set to : " << Misc::data_path << std::endl;
+
+		service.run();
+
+		std::cout << "End of program" << std::endl;
+
+	} else {
+	  usage();
+	}
+
+	return 0;
+}
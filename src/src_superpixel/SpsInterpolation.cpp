@@ -8,6 +8,7 @@
 #include <boost/accumulators/statistics/stats.hpp>
 #include <boost/accumulators/statistics/median.hpp>//for median distances
 #include "SpsMaskMerge.h"
+#include "Tracing.h"
 
 SpsInterpolation::SpsInterpolation() {
 
@@ -23,14 +24,7 @@ SpsInterpolation::SpsInterpolation(const SpsMaskMerge* _merger) {
 
 SpsInterpolation::~SpsInterpolation() {
 
-	if (ocv::is_valid(weights_image)) {
-		/*! Delete weights pointers.*/
-		for (ocv::Timg_ptr::const_iterator it_weights = weights_image.begin(); it_weights != weights_image.end(); ++it_weights) {
-
-			delete (Tweights*)(*it_weights)[0];
-		}
-	}
-	
+	release_weights();
 }
 
 void SpsInterpolation::set_parameters(const Parameters& _parameters) {
@@ -51,18 +45,139 @@ void SpsInterpolation::compute(const SpsMaskMerge* _merger) {
 
 	std::cout << "Computing interpolation weights" << std::endl;
 
+	/*! Weights of a previous computation.*/
+	release_weights();
+
+	compute_weights(_merger, nullptr);
+
+}
+
+void SpsInterpolation::update(const SpsMaskMerge* _merger, const cv::Mat& _labels_previous, const ocv::Tmask& _mask_previous) {
+
+	if (!ocv::is_valid(weights_image) || weights_image.size() != _merger->get_sps()->size() || _labels_previous.size() != weights_image.size() || _mask_previous.size() != weights_image.size()) {
+		compute(_merger);
+		return;
+	}
+
+	std::cout << "Updating interpolation weights" << std::endl;
+
+	/*! Labels, before and after change, having a pixel whose label or mask changed. Other labels keep same pixels and same masked pixels, thus same weights.*/
+	std::set<SuperPixelSegmentation::Tlabel> labels_changed;
+	{
+		Tracing::Scope scope("SpsInterpolation::labels_changed");
+		cv::MatConstIterator_<cv::Vec1i> it_labels_previous = _labels_previous.begin<cv::Vec1i>();
+		cv::MatConstIterator_<cv::Vec1b> it_mask = _merger->get_mask().begin();
+		cv::MatConstIterator_<cv::Vec1b> it_mask_previous = _mask_previous.begin();
+		for (cv::MatConstIterator_<cv::Vec1i> it_labels = _merger->get_labels().begin<cv::Vec1i>(); it_labels != _merger->get_labels().end<cv::Vec1i>(); ++it_labels, ++it_labels_previous, ++it_mask, ++it_mask_previous) {
+
+			if ((*it_labels)[0] != (*it_labels_previous)[0] || (*it_mask)[0] != (*it_mask_previous)[0]) {
+				labels_changed.insert((*it_labels)[0]);
+				labels_changed.insert((*it_labels_previous)[0]);
+			}
+		}
+	}
+
+	/*! Release weights of changed labels. A pixel of an unchanged label keeps its label and mask value, so its weights are still valid.*/
+	cv::MatConstIterator_<cv::Vec1i> it_labels_previous = _labels_previous.begin<cv::Vec1i>();
+	for (ocv::Timg_ptr::iterator it_weights = weights_image.begin(); it_weights != weights_image.end(); ++it_weights, ++it_labels_previous) {
+
+		if ((*it_weights)[0] != 0 && labels_changed.count((*it_labels_previous)[0])) {
+			delete (Tweights*)(*it_weights)[0];
+			*it_weights = 0;
+		}
+	}
+
+	compute_weights(_merger, &labels_changed);
+
+}
+
+void SpsInterpolation::get_weights(SparseWeights& _weights) const {
+
+	_weights.size = weights_image.size();
+	_weights.pixels.clear();
+	_weights.offsets.assign(1, 0);
+	_weights.indices.clear();
+	_weights.values.clear();
+
+	int pixel = 0;
+	for (ocv::Timg_ptr::const_iterator it_weights = weights_image.begin(); it_weights != weights_image.end(); ++it_weights, pixel++) {
+
+		if ((*it_weights)[0] != 0) {
+
+			const Tweights* weights = (const Tweights*)(*it_weights)[0];
+			/*! Weights offsets are relative to previous weight : they are accumulated into pixel indices.*/
+			int index = 0;
+			for (Tweights::const_iterator it_weight = weights->begin(); it_weight != weights->end(); ++it_weight) {
+				index += it_weight->second;
+				_weights.indices.push_back(index);
+				_weights.values.push_back(it_weight->first);
+			}
+			_weights.pixels.push_back(pixel);
+			_weights.offsets.push_back((int)_weights.indices.size());
+		}
+	}
+
+}
+
+void SpsInterpolation::set_weights(const SparseWeights& _weights) {
+
+	release_weights();
+
+	weights_image.create(_weights.size);
+	weights_image.setTo(0);
+
+	for (size_t r = 0; r < _weights.pixels.size(); r++) {
+
+		Tweights* weights = new Tweights;
+		weights->reserve(_weights.offsets[r + 1] - _weights.offsets[r]);
+		/*! Pixel indices back to offsets relative to previous weight.*/
+		int index = 0;
+		for (int w = _weights.offsets[r]; w < _weights.offsets[r + 1]; w++) {
+			weights->push_back(Tweight(_weights.values[w], _weights.indices[w] - index));
+			index = _weights.indices[w];
+		}
+		weights_image(_weights.pixels[r] / _weights.size.width, _weights.pixels[r] % _weights.size.width)[0] = (ocv::Timg_ptr_type)weights;
+	}
+
+}
+
+void SpsInterpolation::release_weights() {
+
+	if (ocv::is_valid(weights_image)) {
+		/*! Delete weights pointers.*/
+		for (ocv::Timg_ptr::iterator it_weights = weights_image.begin(); it_weights != weights_image.end(); ++it_weights) {
+
+			delete (Tweights*)(*it_weights)[0];
+			*it_weights = 0;
+		}
+	}
+
+}
+
+void SpsInterpolation::compute_weights(const SpsMaskMerge* _merger, const std::set<SuperPixelSegmentation::Tlabel>* _labels) {
+
 	bool l_recolored = _merger->get_sps()->is_recolored();
 
-	
 	/*! std::map of all pixels coordatas by label.*/
-	SuperPixelSegmentation::Tlabels_datas labels_datas = _merger->get_sps()->get_labels_datas(_merger->get_labels(), SuperPixelSegmentation::no_label, l_recolored);
-	/*! Compute for each label a coefficient for distance measurement based on superpixels properties.*/
+	SuperPixelSegmentation::Tlabels_datas labels_datas;
+	/*! Coefficient for distance measurement for each label.*/
 	SuperPixelSegmentation::Tlabel_map<double> distance_coefs;
-	calc_distance_coefs(labels_datas, distance_coefs);
 	/*! std::map of unmasked pixels coordatas by label.*/
-	SuperPixelSegmentation::Tlabels_datas labels_datas_unmasked = _merger->get_labels_datas_masked(true, l_recolored);
-	/*! Init image containing pointers to weights.*/
-	weights_image.create(_merger->get_sps()->size());
+	SuperPixelSegmentation::Tlabels_datas labels_datas_unmasked;
+	{
+		Tracing::Scope scope("SpsInterpolation::labels_datas");
+		labels_datas = _merger->get_sps()->get_labels_datas(_merger->get_labels(), SuperPixelSegmentation::no_label, l_recolored);
+		/*! Compute for each label a coefficient for distance measurement based on superpixels properties.*/
+		calc_distance_coefs(labels_datas, distance_coefs);
+		labels_datas_unmasked = _merger->get_labels_datas_masked(true, l_recolored);
+	}
+
+	Tracing::Scope scope("SpsInterpolation::weights");
+	/*! Init image containing pointers to weights. Kept if already allocated : released weights are null.*/
+	if (weights_image.size() != _merger->get_sps()->size()) {
+		weights_image.create(_merger->get_sps()->size());
+		weights_image.setTo(0);
+	}
 
 
 	cv::MatConstIterator_<cv::Vec1b> it_mask = _merger->get_mask().begin();
@@ -94,10 +209,10 @@ void SpsInterpolation::compute(const SpsMaskMerge* _merger) {
 	unsigned int i_mask = 0;
 	for (cv::MatConstIterator_<cv::Vec1i> it_labels = _merger->get_labels().begin<cv::Vec1i>(); it_labels != _merger->get_labels().end<cv::Vec1i>(); ++it_labels, ++it_mask, ++it_image, ++it_weights) {
 
-		/*! If inside the mask.*/
-		if ((*it_mask)[0] == ocv::mask_value) {
+		label_value = (*it_labels)[0];
 
-			label_value = (*it_labels)[0];
+		/*! If inside the mask, and weights are to be computed for its label.*/
+		if ((*it_mask)[0] == ocv::mask_value && (!_labels || _labels->count(label_value))) {
 
 			weights = new Tweights;
 
@@ -120,7 +235,7 @@ void SpsInterpolation::compute(const SpsMaskMerge* _merger) {
 			Misc::display_progression(i_mask, Nmask);
 			i_mask++;
 
-		} else {
+		} else if ((*it_mask)[0] != ocv::mask_value) {
 			/*! If outside the mask, there are no weights.*/
 			*it_weights = 0;
 
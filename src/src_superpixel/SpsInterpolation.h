@@ -5,6 +5,7 @@
 
 #pragma once
 
+#include <set>
 #include "SuperPixelSegmentation.h"
 class SpsMaskMerge;
 
@@ -27,6 +28,15 @@ public :
 		double sigma_coef = 1.;
 	};
 
+	/*! Weights in compressed sparse row form. Row r holds weights of pixel pixels[r] (index in image), from offsets[r] to offsets[r+1] excluded : pixel index in image and value of each weight.*/
+	struct SparseWeights {
+		cv::Size size;
+		std::vector<int> pixels;
+		std::vector<int> offsets;
+		std::vector<int> indices;
+		std::vector<double> values;
+	};
+
 private :
 
 	/*! Image containing pointers to #Tweights.*/
@@ -49,6 +59,14 @@ public:
 	void set_parameters(unsigned int _Nweight_pixels = 10, double _distance_coef = 0.00001, double _sigma_coef = 1.);
 	/*! Start computation.*/
 	void compute(const SpsMaskMerge* _merger);
+	/*! Updates weights after \p _merger was computed again with a new mask, \p _labels_previous and \p _mask_previous being its labels and mask at last computation.
+	Only weights of labels whose pixels or masked pixels changed are computed again, others are kept.*/
+	void update(const SpsMaskMerge* _merger, const cv::Mat& _labels_previous, const ocv::Tmask& _mask_previous);
+	
+	/*! Computed weights in compressed sparse row form.*/
+	void get_weights(SparseWeights& _weights) const;
+	/*! Sets weights from \p _weights instead of computing them, ex : weights written by a previous run. Weights can then be applied.*/
+	void set_weights(const SparseWeights& _weights);
 	
 	/*! Apply interpolation weights (ie: apply convolution) to \p _input_image and save result in \p _output_image.*/
 	template <class Tvec>
@@ -62,6 +80,10 @@ public:
 
 private :
 
+	/*! Deletes weights and sets their pointers to null.*/
+	void release_weights();
+	/*! Computes weights of pixels inside mask whose label is in \p _labels, or of every pixel inside mask if \p _labels is null.*/
+	void compute_weights(const SpsMaskMerge* _merger, const std::set<SuperPixelSegmentation::Tlabel>* _labels);
 	/*! Compute for each label a user-free coefficient applied to distance calculation between two Tcoordata in #calc_distance.*/
 	void calc_distance_coefs(const SuperPixelSegmentation::Tlabels_datas& _labels_datas, SuperPixelSegmentation::Tlabel_map<double>& _distance_coefs) const;
 	/*! Compute the Nweight_pixels mininmum distances corresponding to the Nweight_pixels closest pixels in \p _coordatas relatively to \p _coordata.*/
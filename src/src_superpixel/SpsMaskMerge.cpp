@@ -8,6 +8,7 @@
 #include "misc_funcs.h"//ostream vector
 #include "Contour.h"
 #include "ocv_rw.h"
+#include "Tracing.h"
 /*! For writing video of superpixel merging.*/
 
 SpsMaskMerge::SpsMaskMerge() {
@@ -51,21 +52,21 @@ void SpsMaskMerge::compute(const SuperPixelSegmentation* _sps, const ocv::Tmask&
 
 		mask = _mask;
 
-		if (_image_stats.size() == sps->get_image_original().size()) {
-			image_stats = _image_stats;
-		} else {
-			if (sps->is_recolored()) {
-				image_stats = sps->get_image_recolored();
-			} else {
-				image_stats = sps->get_image_original();
-			}
-		}
+		set_image_stats(_image_stats);
 
 		/*! Compute number of pixels per label in ascending order.*/
-		std::vector< std::pair< std::pair<unsigned int, unsigned int>, SuperPixelSegmentation::Tlabel> > sorted_Nknown_pixels = calc_Nknown_pixels();
+		std::vector< std::pair< std::pair<unsigned int, unsigned int>, SuperPixelSegmentation::Tlabel> > sorted_Nknown_pixels;
+		{
+			Tracing::Scope scope("SpsMaskMerge::Nknown_pixels");
+			sorted_Nknown_pixels = calc_Nknown_pixels();
+		}
 		/*! Merge superpixels.*/
-		merging(sorted_Nknown_pixels);
+		{
+			Tracing::Scope scope("SpsMaskMerge::merging");
+			merging(sorted_Nknown_pixels);
+		}
 
+		Tracing::Scope scope("SpsMaskMerge::display");
 		//sps->show_labels(labels);
 		ocv::Tmask contour;
 		Contour::get_segmentation(labels, contour);
@@ -77,7 +78,9 @@ void SpsMaskMerge::compute(const SuperPixelSegmentation* _sps, const ocv::Tmask&
 		ocv::Timg image_filtered;
 		sps->get_image_segmented(image_filtered, labels_filtered_outside);
 		Contour::apply_segmentation_from_labels(image_filtered, mask, image_filtered, ocv::Tvec(0, 0, 1.));
-		ocv::imwrite("image_filtered", image_filtered);
+		if (parameters.l_write_result) {
+			ocv::imwrite("image_filtered", image_filtered);
+		}
 
 	} else {
 		std::cout << "_sps->size() = " << _sps->size() << ", _mask.size() = " << _mask.size() << std::endl;
@@ -86,6 +89,39 @@ void SpsMaskMerge::compute(const SuperPixelSegmentation* _sps, const ocv::Tmask&
 
 }
 
+void SpsMaskMerge::set_labels(const SuperPixelSegmentation* _sps, const ocv::Tmask& _mask, const cv::Mat& _labels, const ocv::Timg _image_stats) {
+
+	if (_sps->size() == _mask.size() && _labels.size() == _mask.size()) {
+
+		sps = _sps;
+		_labels.copyTo(labels);
+		mask = _mask;
+
+		set_image_stats(_image_stats);
+
+		get_filtered_outside_labels(labels_filtered_outside);
+
+	} else {
+		std::cout << "_sps->size() = " << _sps->size() << ", _mask.size() = " << _mask.size() << ", _labels.size() = " << _labels.size() << std::endl;
+		DEBUG_BREAK;
+	}
+
+}
+
+void SpsMaskMerge::set_image_stats(const ocv::Timg& _image_stats) {
+
+	if (_image_stats.size() == sps->get_image_original().size()) {
+		image_stats = _image_stats;
+	} else {
+		if (sps->is_recolored()) {
+			image_stats = sps->get_image_recolored();
+		} else {
+			image_stats = sps->get_image_original();
+		}
+	}
+
+}
+
 const SuperPixelSegmentation* SpsMaskMerge::get_sps() const {
 
 	return sps;
@@ -19,6 +19,8 @@ public :
 		unsigned int Nknown_pixels_min = (unsigned int)20;
 		/*! Coefficient applied to standard deviation measure (versus median) for superpixels when computing distance between superpixels.*/
 		float merge_coef = float(10.);
+		/*! Whether image of merged superpixels is written, for display.*/
+		bool l_write_result = true;
 	};
 
 private :
@@ -45,6 +47,8 @@ public:
 	void set_parameters(unsigned int _Nknown_pixels_min=100, float _merge_coef=1.);
 	/*! Start computation.*/
 	void compute(const SuperPixelSegmentation* _sps, const ocv::Tmask& _mask, const ocv::Timg _image_stats=ocv::Timg());
+	/*! Sets merged labels \p _labels instead of computing them, ex : labels written by a previous run. \p _sps only needs its image (see SuperPixelSegmentation::set_image).*/
+	void set_labels(const SuperPixelSegmentation* _sps, const ocv::Tmask& _mask, const cv::Mat& _labels, const ocv::Timg _image_stats = ocv::Timg());
 
 	const SuperPixelSegmentation* get_sps() const;
 	const ocv::Tmask& get_mask() const;
@@ -63,6 +67,8 @@ public:
 	SuperPixelSegmentation::Tlabels_datas get_labels_datas_masked(bool _l_opposite=false, bool _l_recolored=false) const;
 
 private :
+	/*! Sets #image_stats : \p _image_stats if it has image size, otherwise image used by segmentation.*/
+	void set_image_stats(const ocv::Timg& _image_stats);
 	/*! Returns a sorted vector of number of unmasked pixels per superpixel. Each number goes with the corresponding label.*/
 	std::vector< std::pair< std::pair<unsigned int, unsigned int>, SuperPixelSegmentation::Tlabel> > calc_Nknown_pixels() const;
 	/*! Enforce #Nknown_pixels_min criteria to \p _sorted_Nknown_pixels.*/
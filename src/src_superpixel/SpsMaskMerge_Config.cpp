@@ -9,7 +9,8 @@
 
 const std::map<ConfigParametersSpecializations<SpsMaskMerge>::ParametersId, std::string> ConfigParametersSpecializations<SpsMaskMerge>::all_parameters = {
 	{ Nknown_pixels_min, "Nknown_pixels_min" },
-{ merge_coef, "merge_coef" }
+{ merge_coef, "merge_coef" },
+{ l_write_result, "l_write_result" }
 };
 
 bool ConfigParametersSpecializations<SpsMaskMerge>::set_value(SpsMaskMerge::Parameters& _parameters, const std::string& _parameter_name, const std::vector<std::string>& _sub_strings, const std::string& _config_directory) {
@@ -24,6 +25,10 @@ bool ConfigParametersSpecializations<SpsMaskMerge>::set_value(SpsMaskMerge::Para
 
 		l_keep_reading = ConfigParameter::read(_parameters.merge_coef, _sub_strings, _parameter_name);
 
+	} else if (_parameter_name == all_parameters.at(ParametersId::l_write_result)) {
+
+		l_keep_reading = ConfigParameter::read(_parameters.l_write_result, _sub_strings, _parameter_name);
+
 	} else {
 		ConfigBase::display_unknown_parameter(_parameter_name);
 		l_keep_reading = false;
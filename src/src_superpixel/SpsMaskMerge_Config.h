@@ -14,7 +14,8 @@ struct ConfigParametersSpecializations<SpsMaskMerge> {
 private:
 	enum ParametersId {
 		Nknown_pixels_min,
-		merge_coef
+		merge_coef,
+		l_write_result
 	};
 	static const std::map<ParametersId, std::string> all_parameters;
 
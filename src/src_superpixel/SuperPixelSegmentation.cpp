@@ -162,6 +162,20 @@ void SuperPixelSegmentation::compute(const ocv::Timg& _image) {
 
 }
 
+void SuperPixelSegmentation::set_image(const ocv::Timg& _image) {
+
+	clear();
+
+	image_original = _image;
+
+	if (parameters.conversion_type >= 0) {
+		cvtColor(image_original, image_recolored, parameters.conversion_type);
+	} else {
+		image_recolored = image_original;
+	}
+
+}
+
 void SuperPixelSegmentation::compute(const ocv::Timg& _image, Result& _result) {
 
 	std::cout << "Computing superpixel segmentation" << std::endl;
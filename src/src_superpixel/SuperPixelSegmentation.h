@@ -99,6 +99,8 @@ public:
 	/*! Start computation.*/
 	void compute(const ocv::Timg& _image);
 	void compute(const ocv::Timg& _image, Result& _result);
+	/*! Sets image and its recolored version without segmenting it : there are no labels. Convenient when merged labels are already known (see SpsMaskMerge::set_labels).*/
+	void set_image(const ocv::Timg& _image);
 
 	const ocv::Timg& get_image_original() const;
 	const ocv::Timg& get_image_recolored() const;
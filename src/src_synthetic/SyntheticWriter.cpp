@@ -0,0 +1,57 @@
+/******************************************************************/
+/***                Fast Inpainting, INRIA license				  */
+/******************************************************************/
+
+#include "SyntheticWriter.h"
+#include "ocv_rw.h"
+
+SyntheticWriter::SyntheticWriter() {}
+
+SyntheticWriter::~SyntheticWriter() {}
+
+void SyntheticWriter::set_parameters(const Parameters& _parameters) {
+
+	parameters = _parameters;
+}
+
+const SyntheticWriter::Parameters& SyntheticWriter::get_parameters() const {
+
+	return parameters;
+}
+
+void SyntheticWriter::write() const {
+
+	SyntheticLightField synthetic(parameters.synthetic_parameters);
+
+	SubaperturesData<> subapertures;
+	ocv::Tmask mask;
+	ocv::Timg inpainted_image;
+	synthetic.generate(subapertures, mask, inpainted_image);
+
+	const ocv::Range<ocv::Tvalue> range_image((ocv::Tvalue)0., (ocv::Tvalue)1.);
+
+	std::cout << "Writing synthetic light field" << std::endl;
+	Misc::create_directory("light_field/");
+	subapertures.imwrite("light_field/", range_image.first, range_image.second);
+
+	cv::imwrite(Misc::to_data_path("mask" + ocv::write_extension), mask);
+	ocv::imwrite("inpainted", inpainted_image, range_image);
+
+	UVindices center_indices = synthetic.get_center_indices();
+	std::cout << "Inpainted subaperture position : " << center_indices.first << " " << center_indices.second << std::endl;
+
+	if (parameters.l_ground_truth) {
+
+		std::cout << "Writing ground truth" << std::endl;
+		SubaperturesData<> subapertures_ground_truth;
+		synthetic.generate_ground_truth(subapertures_ground_truth);
+		Misc::create_directory("ground_truth/");
+		subapertures_ground_truth.imwrite("ground_truth/", range_image.first, range_image.second);
+
+		ocv::Timg1 disparity;
+		synthetic.get_disparity(disparity);
+		const Fpair& disparity_range = parameters.synthetic_parameters.disparity_range;
+		ocv::imwrite("disparity", disparity, ocv::Range<ocv::Tvalue>((ocv::Tvalue)std::min(disparity_range.first, disparity_range.second), (ocv::Tvalue)std::max(disparity_range.first, disparity_range.second)));
+	}
+
+}
@@ -0,0 +1,41 @@
+/******************************************************************/
+/***                Fast Inpainting, INRIA license				  */
+/******************************************************************/
+
+#pragma once
+
+#include "SyntheticLightField.h"
+
+
+/*! Writes a synthetic light field and its inpainting inputs and ground truth in data path :
+light_field/ (subapertures), mask.png, inpainted.png (center subaperture without object), ground_truth/ (light field without object), disparity.png.*/
+class SyntheticWriter {
+
+public :
+
+	struct Parameters {
+		/*! Synthetic light field parameters.*/
+		SyntheticLightField::Parameters synthetic_parameters;
+		/*! Path where data are written.*/
+		std::string data_path;
+		/*! Whether light field without object and disparity are written.*/
+		bool l_ground_truth = true;
+	};
+
+private :
+
+	Parameters parameters;
+
+public:
+	SyntheticWriter();
+	~SyntheticWriter();
+
+	void set_parameters(const Parameters& _parameters);
+	const Parameters& get_parameters() const;
+
+	/*! Generates and writes light field.*/
+	void write() const;
+
+};
+
+#include "SyntheticWriter_Config.h"
@@ -0,0 +1,53 @@
+/******************************************************************/
+/***                Fast Inpainting, INRIA license				  */
+/******************************************************************/
+
+#include "SyntheticWriter_Config.h"
+#include "misc_funcs.h"
+#include "ConfigParameter.h"
+#include "ConfigReader.h"
+
+const std::map<ConfigParametersSpecializations<SyntheticWriter>::ParametersId, std::string> ConfigParametersSpecializations<SyntheticWriter>::all_parameters = {
+	{ synthetic_config_path, "synthetic_config_path" },
+{ data_path, "data_path" },
+{ l_ground_truth, "l_ground_truth" }
+};
+
+bool ConfigParametersSpecializations<SyntheticWriter>::set_value(SyntheticWriter::Parameters& _parameters, const std::string& _parameter_name, const std::vector<std::string>& _sub_strings, const std::string& _config_directory) {
+
+	bool l_keep_reading = true;
+
+	if (_parameter_name == all_parameters.at(ParametersId::synthetic_config_path)) {
+
+		std::string synthetic_config_path;
+		l_keep_reading = ConfigParameter::read(synthetic_config_path, _sub_strings, _parameter_name);
+		l_keep_reading &= ConfigReader::read<SyntheticLightField>(_parameters.synthetic_parameters, Misc::concat_path_and_filename(_config_directory, synthetic_config_path));
+
+	} else if (_parameter_name == all_parameters.at(ParametersId::data_path)) {
+
+		l_keep_reading = ConfigParameter::read(_parameters.data_path, _sub_strings, _parameter_name);
+
+	} else if (_parameter_name == all_parameters.at(ParametersId::l_ground_truth)) {
+
+		l_keep_reading = ConfigParameter::read(_parameters.l_ground_truth, _sub_strings, _parameter_name);
+
+	} else {
+		ConfigBase::display_unknown_parameter(_parameter_name);
+		l_keep_reading = false;
+	}
+
+	return l_keep_reading;
+}
+
+void ConfigParametersSpecializations<SyntheticWriter>::deduce_values(SyntheticWriter::Parameters& _parameters) {
+
+}
+
+void ConfigParametersSpecializations<SyntheticWriter>::error_message() {
+
+}
+
+std::vector<std::string> ConfigParametersSpecializations<SyntheticWriter>::check_read_parameters(const std::vector<std::string>& _read_parameters) {
+
+	return ConfigParametersSpecializationsBase::check_read_all_parameters(all_parameters, _read_parameters);
+}
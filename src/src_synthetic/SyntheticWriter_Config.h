@@ -0,0 +1,27 @@
+/******************************************************************/
+/***                Fast Inpainting, INRIA license				  */
+/******************************************************************/
+
+#pragma once
+#include "ConfigParameters.h"
+#include "SyntheticWriter.h"
+
+
+template <>
+struct ConfigParametersSpecializations<SyntheticWriter> {
+
+private :
+	enum ParametersId { synthetic_config_path,
+		data_path,
+		l_ground_truth,
+};
+	static const std::map<ParametersId, std::string> all_parameters;
+
+public:
+
+	static bool set_value(SyntheticWriter::Parameters& _parameters, const std::string& _parameter_name, const std::vector<std::string>& _sub_strings, const std::string& _config_directory);
+	static void deduce_values(SyntheticWriter::Parameters& _parameters);
+	static void error_message();
+	static std::vector<std::string> check_read_parameters(const std::vector<std::string>& _read_parameters);
+
+};
@@ -0,0 +1,35 @@
+/******************************************************************/
+/***                Fast Inpainting, INRIA license				  */
+/******************************************************************/
+
+#include "SyntheticWriter.h"
+#include "ConfigReader.h"
+
+#include "version.h"
+
+void usage() {
+  std::cout << "FastLFSynthetic " << FI_VERSION_MAJOR<< "." << FI_VERSION_MINOR << "." << FI_VERSION_PATCH << " : " << std::endl;
+  std::cout << "    Usage : ./FastLFSynthetic <config-file>" << std::endl;
+  std::cout << "    <config-file> full path to the configuration file providing synthetic light field parameters." << std::endl;
+  exit(0);
+}
+
+int main(int argc, char** argv) {
+
+	SyntheticWriter writer;
+
+	if (ConfigReader::read(writer, argc, argv)) {
+
+		Misc::data_path = writer.get_parameters().data_path;
+		std::cout << "Data path is set to : " << Misc::data_path << std::endl;
+
+		writer.write();
+
+		std::cout << "End of program" << std::endl;
+
+	} else {
+	  usage();
+	}
+
+	return 0;
+}
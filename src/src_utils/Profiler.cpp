@@ -0,0 +1,247 @@
+/******************************************************************/
+/***            Pierre Allain, INRIA, February 2020				  */
+/***        GNU Affero General Public License version 3			  */
+/******************************************************************/
+
+#include "Profiler.h"
+#include "misc_funcs.h"
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <boost/thread.hpp>
+
+#if defined(_WIN32)
+#include <windows.h>
+#include <psapi.h>
+#if defined(_MSC_VER)
+#pragma comment(lib, "psapi.lib")
+#endif
+#else
+#include <time.h>
+#include <sys/resource.h>
+#endif
+
+namespace {
+
+	/*! Shared state of the profiler.*/
+	struct ProfilerData {
+		bool l_enabled = true;
+		Profiler::Clock::time_point start = Profiler::Clock::now();
+		std::vector<Profiler::Record> records;
+		boost::mutex mutex;
+	};
+
+	ProfilerData& profiler_data() {
+		static ProfilerData data;
+		return data;
+	}
+
+	/*! Stack of scope paths of the calling thread.*/
+	std::vector<std::string>& thread_paths() {
+		static thread_local std::vector<std::string> paths;
+		return paths;
+	}
+
+}
+
+Profiler::Scope::Scope(const std::string& _name) {
+
+	init(_name, get_current_path());
+}
+
+Profiler::Scope::Scope(const std::string& _name, const std::string& _parent_path) {
+
+	init(_name, _parent_path);
+}
+
+void Profiler::Scope::init(const std::string& _name, const std::string& _parent_path) {
+
+	if (_parent_path.empty()) {
+		path = _name;
+		depth = 0;
+	} else {
+		path = _parent_path + "/" + _name;
+		depth = (unsigned int)std::count(path.begin(), path.end(), '/');
+	}
+
+	thread_paths().push_back(path);
+	cpu_start = get_thread_cpu_time();
+	start = Clock::now();
+}
+
+Profiler::Scope::~Scope() {
+
+	const Clock::time_point end = Clock::now();
+	const double cpu_end = get_thread_cpu_time();
+
+	thread_paths().pop_back();
+
+	Record record;
+	record.path = path;
+	record.depth = depth;
+	record.wall_time = std::chrono::duration<double>(end - start).count();
+	record.cpu_time = cpu_end - cpu_start;
+	record.peak_rss = get_peak_rss();
+	std::ostringstream thread_id;
+	thread_id << boost::this_thread::get_id();
+	record.thread_id = thread_id.str();
+
+	if (Misc::l_verbose_high) {
+		std::cout << path << " time : " << to_string_duration(record.wall_time) << std::endl;
+	}
+
+	ProfilerData& data = profiler_data();
+	boost::lock_guard<boost::mutex> lock(data.mutex);
+	if (data.l_enabled) {
+		record.start = std::chrono::duration<double>(start - data.start).count();
+		data.records.push_back(record);
+	}
+}
+
+double Profiler::Scope::elapsed() const {
+
+	return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+const std::string& Profiler::Scope::get_path() const {
+
+	return path;
+}
+
+void Profiler::set_enabled(const bool _l_enabled) {
+
+	ProfilerData& data = profiler_data();
+	boost::lock_guard<boost::mutex> lock(data.mutex);
+	data.l_enabled = _l_enabled;
+}
+
+bool Profiler::is_enabled() {
+
+	ProfilerData& data = profiler_data();
+	boost::lock_guard<boost::mutex> lock(data.mutex);
+	return data.l_enabled;
+}
+
+void Profiler::reset() {
+
+	ProfilerData& data = profiler_data();
+	boost::lock_guard<boost::mutex> lock(data.mutex);
+	data.records.clear();
+	data.start = Clock::now();
+}
+
+std::string Profiler::get_current_path() {
+
+	if (thread_paths().empty()) {
+		return "";
+	} else {
+		return thread_paths().back();
+	}
+}
+
+std::vector<Profiler::Record> Profiler::get_records() {
+
+	ProfilerData& data = profiler_data();
+	boost::lock_guard<boost::mutex> lock(data.mutex);
+	return data.records;
+}
+
+bool Profiler::write_report(const std::string& _file_path) {
+
+	std::vector<Record> records = get_records();
+	/*! Records are pushed when stages end : sort them by start time for readability.*/
+	std::stable_sort(records.begin(), records.end(), [](const Record& _record1, const Record& _record2) { return _record1.start < _record2.start; });
+
+	std::ofstream file(_file_path);
+
+	if (file.is_open()) {
+
+		file << std::setprecision(6) << std::fixed;
+		file << "{" << std::endl;
+		file << "\t\"peak_rss_kB\" : " << get_peak_rss() << "," << std::endl;
+		file << "\t\"stages\" : [" << std::endl;
+		for (unsigned int i = 0; i < records.size(); i++) {
+			const Record& record = records[i];
+			file << "\t\t{ ";
+			file << "\"path\" : \"" << Misc::json_escape(record.path) << "\", ";
+			file << "\"depth\" : " << record.depth << ", ";
+			file << "\"thread\" : \"" << Misc::json_escape(record.thread_id) << "\", ";
+			file << "\"start_s\" : " << record.start << ", ";
+			file << "\"wall_s\" : " << record.wall_time << ", ";
+			file << "\"cpu_s\" : " << record.cpu_time << ", ";
+			file << "\"peak_rss_kB\" : " << record.peak_rss;
+			file << " }";
+			if (i + 1 < records.size()) {
+				file << ",";
+			}
+			file << std::endl;
+		}
+		file << "\t]" << std::endl;
+		file << "}" << std::endl;
+
+		return true;
+
+	} else {
+		std::cout << "WARNING : Failed to write profiling report " << _file_path << std::endl;
+		return false;
+	}
+
+}
+
+double Profiler::get_thread_cpu_time() {
+
+#if defined(_WIN32)
+	FILETIME creation_time, exit_time, kernel_time, user_time;
+	if (GetThreadTimes(GetCurrentThread(), &creation_time, &exit_time, &kernel_time, &user_time)) {
+		ULARGE_INTEGER kernel, user;
+		kernel.LowPart = kernel_time.dwLowDateTime;
+		kernel.HighPart = kernel_time.dwHighDateTime;
+		user.LowPart = user_time.dwLowDateTime;
+		user.HighPart = user_time.dwHighDateTime;
+		/*! Units of 100 ns.*/
+		return double(kernel.QuadPart + user.QuadPart) * 1e-7;
+	} else {
+		return 0.;
+	}
+#else
+	timespec time;
+	if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time) == 0) {
+		return double(time.tv_sec) + double(time.tv_nsec) * 1e-9;
+	} else {
+		return 0.;
+	}
+#endif
+}
+
+long Profiler::get_peak_rss() {
+
+#if defined(_WIN32)
+	PROCESS_MEMORY_COUNTERS counters;
+	if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+		return long(counters.PeakWorkingSetSize / 1024);
+	} else {
+		return 0;
+	}
+#else
+	rusage usage;
+	if (getrusage(RUSAGE_SELF, &usage) == 0) {
+#if defined(__APPLE__)
+		/*! Bytes on macOS.*/
+		return long(usage.ru_maxrss / 1024);
+#else
+		return long(usage.ru_maxrss);
+#endif
+	} else {
+		return 0;
+	}
+#endif
+}
+
+std::string Profiler::to_string_duration(const double _duration) {
+
+	std::ostringstream stream;
+	stream << (int)_duration / 60 << " min, " << (long)_duration % 60 << " s, " << (long)(_duration*1000.) % 1000 << " ms";
+	return stream.str();
+}
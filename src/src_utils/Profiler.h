@@ -0,0 +1,80 @@
+/******************************************************************/
+/***            Pierre Allain, INRIA, February 2020				  */
+/***        GNU Affero General Public License version 3			  */
+/******************************************************************/
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <chrono>
+
+/*! Hierarchical wall clock profiler. Stages are measured by #Profiler::Scope instances.
+Nested scopes of a same thread form a tree, identified by their path (ex : "run/inpaint/disparity").
+For each stage are recorded wall time (steady clock), CPU time of the calling thread and process peak resident memory.*/
+class Profiler {
+
+public:
+
+	typedef std::chrono::steady_clock Clock;
+
+	/*! Measure of a stage.*/
+	struct Record {
+		/*! Hierarchical path of the stage.*/
+		std::string path;
+		/*! Depth of the stage in the hierarchy.*/
+		unsigned int depth;
+		/*! Thread in which stage ran.*/
+		std::string thread_id;
+		/*! Start time relatively to profiler start, in seconds.*/
+		double start;
+		/*! Wall time, in seconds.*/
+		double wall_time;
+		/*! CPU time of the thread, in seconds.*/
+		double cpu_time;
+		/*! Peak resident memory of the process at the end of the stage, in kB.*/
+		long peak_rss;
+	};
+
+	/*! Measures a stage from construction to destruction.*/
+	class Scope {
+
+	private:
+		std::string path;
+		unsigned int depth;
+		Clock::time_point start;
+		double cpu_start;
+
+	public:
+		/*! Stage is a child of current scope of the calling thread.*/
+		Scope(const std::string& _name);
+		/*! Stage is a child of \p _parent_path. Convenient for stages running in other threads.*/
+		Scope(const std::string& _name, const std::string& _parent_path);
+		~Scope();
+
+		/*! Elapsed wall time since construction, in seconds.*/
+		double elapsed() const;
+		const std::string& get_path() const;
+
+	private:
+		void init(const std::string& _name, const std::string& _parent_path);
+	};
+
+	/*! Enable/disable recording. Enabled by default.*/
+	static void set_enabled(const bool _l_enabled);
+	static bool is_enabled();
+	/*! Clears records and resets start time.*/
+	static void reset();
+	/*! Path of current scope of the calling thread. Empty if none.*/
+	static std::string get_current_path();
+	static std::vector<Record> get_records();
+	/*! Writes records as JSON in \p _file_path.*/
+	static bool write_report(const std::string& _file_path);
+
+	/*! CPU time consumed by calling thread, in seconds.*/
+	static double get_thread_cpu_time();
+	/*! Peak resident memory of the process, in kB.*/
+	static long get_peak_rss();
+	/*! Convenient display of a duration : "X min, Y s, Z ms".*/
+	static std::string to_string_duration(const double _duration);
+};
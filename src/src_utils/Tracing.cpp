@@ -0,0 +1,112 @@
+/******************************************************************/
+/***            Pierre Allain, INRIA, February 2020				  */
+/***        GNU Affero General Public License version 3			  */
+/******************************************************************/
+
+#include "Tracing.h"
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <chrono>
+#include <boost/thread.hpp>
+
+std::atomic<bool> Tracing::l_enabled(false);
+
+namespace {
+
+	struct Event {
+		const char* name;
+		int index1;
+		int index2;
+		int thread;
+		long long start;
+		long long duration;
+	};
+
+	struct TracingData {
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		std::vector<Event> events;
+		boost::mutex mutex;
+	};
+
+	TracingData& tracing_data() {
+		static TracingData data;
+		return data;
+	}
+
+	/*! Small integer identifying calling thread, as expected by trace viewers.*/
+	int thread_index() {
+		static std::atomic<int> count(0);
+		static thread_local int index = count++;
+		return index;
+	}
+
+}
+
+void Tracing::set_enabled(const bool _l_enabled) {
+
+	/*! Make sure reference time is set before any event.*/
+	tracing_data();
+	l_enabled.store(_l_enabled);
+}
+
+void Tracing::clear() {
+
+	TracingData& data = tracing_data();
+	boost::lock_guard<boost::mutex> lock(data.mutex);
+	data.events.clear();
+}
+
+long long Tracing::now() {
+
+	return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - tracing_data().start).count();
+}
+
+void Tracing::record(const char* _name, const int _index1, const int _index2, const long long _start, const long long _end) {
+
+	Event event;
+	event.name = _name;
+	event.index1 = _index1;
+	event.index2 = _index2;
+	event.thread = thread_index();
+	event.start = _start;
+	event.duration = _end - _start;
+
+	TracingData& data = tracing_data();
+	boost::lock_guard<boost::mutex> lock(data.mutex);
+	data.events.push_back(event);
+}
+
+bool Tracing::write(const std::string& _file_path) {
+
+	TracingData& data = tracing_data();
+	boost::lock_guard<boost::mutex> lock(data.mutex);
+
+	std::ofstream file(_file_path);
+
+	if (file.is_open()) {
+
+		file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[" << std::endl;
+		for (unsigned int i = 0; i < data.events.size(); i++) {
+			const Event& event = data.events[i];
+			file << "{\"name\":\"" << event.name << "\",\"cat\":\"FastLFInpainting\",\"ph\":\"X\",\"pid\":0";
+			file << ",\"tid\":" << event.thread << ",\"ts\":" << event.start << ",\"dur\":" << event.duration;
+			if (event.index1 >= 0 || event.index2 >= 0) {
+				file << ",\"args\":{\"u\":" << event.index1 << ",\"v\":" << event.index2 << "}";
+			}
+			file << "}";
+			if (i + 1 < data.events.size()) {
+				file << ",";
+			}
+			file << std::endl;
+		}
+		file << "]}" << std::endl;
+
+		return true;
+
+	} else {
+		std::cout << "WARNING : Failed to write trace " << _file_path << std::endl;
+		return false;
+	}
+
+}
@@ -0,0 +1,74 @@
+/******************************************************************/
+/***            Pierre Allain, INRIA, February 2020				  */
+/***        GNU Affero General Public License version 3			  */
+/******************************************************************/
+
+#pragma once
+
+#include <string>
+#include <atomic>
+
+/*! Optional recording of execution events, written in Chrome trace-event JSON format (chrome://tracing or Perfetto).
+Disabled by default : a #Tracing::Scope then only costs a test on an atomic flag.*/
+class Tracing {
+
+public:
+
+	/*! Records an event from construction to destruction if tracing is enabled. \p _name must be a string literal (it is not copied).*/
+	class Scope {
+
+	private:
+		const char* name;
+		int index1;
+		int index2;
+		long long start;
+		bool l_active;
+
+	public:
+		Scope(const char* _name);
+		/*! Event with two integer arguments, ex : angular coordinates of a view.*/
+		Scope(const char* _name, const int _index1, const int _index2);
+		~Scope();
+	};
+
+	static void set_enabled(const bool _l_enabled);
+	static bool is_enabled();
+	/*! Clears recorded events.*/
+	static void clear();
+	/*! Writes recorded events in \p _file_path.*/
+	static bool write(const std::string& _file_path);
+
+private:
+
+	static std::atomic<bool> l_enabled;
+
+	/*! Time in microseconds since tracing start.*/
+	static long long now();
+	static void record(const char* _name, const int _index1, const int _index2, const long long _start, const long long _end);
+};
+
+inline bool Tracing::is_enabled() {
+
+	return l_enabled.load(std::memory_order_relaxed);
+}
+
+inline Tracing::Scope::Scope(const char* _name) : name(_name), index1(-1), index2(-1), start(0), l_active(is_enabled()) {
+
+	if (l_active) {
+		start = now();
+	}
+}
+
+inline Tracing::Scope::Scope(const char* _name, const int _index1, const int _index2) : name(_name), index1(_index1), index2(_index2), start(0), l_active(is_enabled()) {
+
+	if (l_active) {
+		start = now();
+	}
+}
+
+inline Tracing::Scope::~Scope() {
+
+	if (l_active) {
+		record(name, index1, index2, start, now());
+	}
+}
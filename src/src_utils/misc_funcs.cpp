@@ -5,6 +5,7 @@
 
 
 #include "misc_funcs.h"
+#include <iomanip>
 
 /*! Bug in old versions of boost*/
 #include <boost/version.hpp>
@@ -165,6 +166,33 @@ void Misc::delete_files_in_directory(const std::string& _directory_path, const s
 	}
 }
 
+long long Misc::get_last_write_time(const std::string& _path) {
+
+	boost::system::error_code error;
+	std::time_t time = boost::filesystem::last_write_time(boost::filesystem::path(_path), error);
+
+	if (error) {
+		return -1;
+	} else {
+		return (long long)time;
+	}
+}
+
+unsigned int Misc::count_directory_entries(const std::string& _directory_path) {
+
+	namespace fs = boost::filesystem;
+
+	unsigned int count = 0;
+	if (Misc::is_directory(_directory_path)) {
+		fs::directory_iterator end;
+		for (fs::directory_iterator it(_directory_path); it != end; ++it) {
+			count++;
+		}
+	}
+
+	return count;
+}
+
 /*! Return file names relatively to _directory_path (doesn't return full path).*/
 std::vector<std::string> Misc::get_file_names(const std::string& _directory_path, FileType _file_type) {
 
@@ -304,6 +332,28 @@ std::vector<std::string> Misc::get_sub_strings(const std::string& _string, const
 	return sub_strings;
 }
 
+std::string Misc::json_escape(const std::string& _string) {
+
+	std::string escaped;
+	for (char c : _string) {
+		if (c == '"' || c == '\\') {
+			escaped += '\\';
+			escaped += c;
+		} else if (c == '\n') {
+			escaped += "\\n";
+		} else if (c == '\t') {
+			escaped += "\\t";
+		} else if ((unsigned char)c < 0x20) {
+			std::ostringstream code;
+			code << "\\u" << std::hex << std::setw(4) << std::setfill('0') << int(c);
+			escaped += code.str();
+		} else {
+			escaped += c;
+		}
+	}
+	return escaped;
+}
+
 std::string Misc::int_to_string(const unsigned int i, const unsigned int _Ndigits) {
 
 	std::string i_string = to_string(i);
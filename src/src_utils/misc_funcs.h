@@ -44,6 +44,11 @@ namespace Misc {
 	void copy_file_in_directory(const std::string& _file_path, const std::string& _destination_directory_path);
 	void delete_files_in_directory(const std::string& _directory_path, const std::string _file_extension="");
 
+	/*! Last modification time of file or directory, in seconds since epoch. -1 if it doesn't exist.*/
+	long long get_last_write_time(const std::string& _path);
+	/*! Number of entries (files and directories) of directory, without recursion.*/
+	unsigned int count_directory_entries(const std::string& _directory_path);
+
 	enum FileType { file, directory, both };
 	/*! Return file names relatively to _directory_path (doesn't return full path).*/
 	std::vector<std::string> get_file_names(const std::string& _directory_path, FileType _file_type = FileType::file);
@@ -61,6 +66,8 @@ namespace Misc {
 
 
 	std::vector<std::string> get_sub_strings(const std::string& _string, const char _separator = ' ');
+	/*! Escapes \p _string to be written inside quotes of a JSON string.*/
+	std::string json_escape(const std::string& _string);
 
 	/*! Ndigits up to 6 for now. A better implementation is easy to make.*/
 	std::string int_to_string(const unsigned int i, const unsigned int _Ndigits = 3);